@@ -52,6 +52,9 @@
   #include <stdint.h>
   extern uint32_t SystemCoreClock;
   extern void Error_Handler(void);
+  extern void statsInitTimer(void);
+  extern uint32_t statsGetCounter(void);
+  extern volatile uint32_t statsContextSwitches;
 #endif
 
 #define configENABLE_FPU						0
@@ -65,21 +68,32 @@
 #define configTICK_RATE_HZ						((TickType_t)1000)
 #define configMAX_PRIORITIES					( 7 )
 #define configMINIMAL_STACK_SIZE				((uint16_t)128)
-#define configTOTAL_HEAP_SIZE					((size_t) (3 * 1024))
+#define configTOTAL_HEAP_SIZE					((size_t) (3 * 1024 + 512))
 #define configMAX_TASK_NAME_LEN					( 16 )
 #define configUSE_16_BIT_TICKS					0
 #define configUSE_MUTEXES						1
 #define configQUEUE_REGISTRY_SIZE				8
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION	0
 
-
-/* Software timer definitions. */
-/*
+/* Run time statistics: per-task CPU time is accumulated from a free-running
+   1 MHz TIM2 counter (see sys_stats.c), context switches are counted by the
+   trace hook. */
+#define configGENERATE_RUN_TIME_STATS			1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	statsInitTimer()
+#define portGET_RUN_TIME_COUNTER_VALUE()			statsGetCounter()
+#define traceTASK_SWITCHED_IN()					(statsContextSwitches++)
+
+
+/* Software timer definitions. The timer daemon runs below the application
+   tasks and performs the deferred Flash settings write (see rtc_helpers.c).
+   Its stack holds the whole Flash path (settings write, log append, page
+   switch with erase and program, HAL Flash calls) plus the exception frame
+   of an interrupt taken meanwhile: about 90 words, so 128 leaves a margin.
+   Check the "STT" diagnostic item (free words) after changing that path. */
 #define configUSE_TIMERS				1
-#define configTIMER_TASK_PRIORITY		( 2 )
+#define configTIMER_TASK_PRIORITY		( 1 )
 #define configTIMER_QUEUE_LENGTH		5
-#define configTIMER_TASK_STACK_DEPTH	( 80 )
-*/
+#define configTIMER_TASK_STACK_DEPTH	( 128 )
 
 /* Defaults to size_t for backward compatibility, but can be changed
    if lengths will always be less than the number of bytes in a size_t. */
@@ -102,6 +116,9 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil					1
 #define INCLUDE_vTaskDelay						1
 #define INCLUDE_xTaskGetSchedulerState			1
+#define INCLUDE_xTaskGetIdleTaskHandle			1
+#define INCLUDE_uxTaskGetStackHighWaterMark		1
+#define INCLUDE_xTimerPendFunctionCall			1
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
@@ -17,6 +17,8 @@
 #include "rtos_init.h"
 
 void clockTask(void *parameters);
+void clockPowerFail(void);
+void coilInitPwm(void);
 
 /*  
  *   Clock Task Structure and definitions
@@ -34,8 +36,40 @@ void clockTask(void *parameters);
 #define COIL_EXCITE_TIME		200
 #define COIL_EXTRA_TIME			0
 
+// Coil drive: full-duty pull-in, then a reduced-duty hold PWM (tune per mechanism)
+#define COIL_PULLIN_TIME		100		// Full drive at the start of the pulse (ms, covers the flap travel)
+#define COIL_HOLD_DUTY			30		// Drive duty for the rest of the pulse (%, 100 = full drive throughout)
+#define COIL_PWM_PERIOD			200		// COIL_TIMER_HZ counts: 20 kHz, above the audible band
+#define COIL_CCR_FULL			COIL_PWM_PERIOD
+#define COIL_CCR_HOLD			((COIL_PWM_PERIOD * COIL_HOLD_DUTY) / 100)
+
+#if (COIL_PULLIN_TIME > COIL_EXCITE_TIME)
+#error "COIL_PULLIN_TIME must not exceed COIL_EXCITE_TIME"
+#endif
+
+// Minute flip timing (coil energized early so the flap lands on :00)
+#define COIL_FLIP_LATENCY		100		// Initial energize to flap landing estimate (ms)
+#define COIL_LATENCY_FILTER		2		// Latency average weight: new sample counts 1/2^n
+
+// Power-fail commit thresholds (time actuated before the supply dropped)
+#define COIL_COMMIT_TIME		100		// Coil energized long enough to flip the minute flap
+#define SERVO_COMMIT_TIME		SERVO_ENGAGE_TIME	// Servo reached the engage position
+
+// Actuation in progress (seen by the power-fail handler)
+enum mechStepEnum{
+	STEP_NONE,
+	STEP_COIL,
+	STEP_SERVO,
+};
+
 // Timeouts and delays
 #define CLOCK_UPDATE_INTERVAL	100
 
+// Drift handling (minutes of mechanical lag behind the RTC)
+#define CLOCK_MINUTES_DAY		1440
+#define CLOCK_AHEAD_WAIT		30		// Mechanism ahead by up to this: wait for the RTC
+#define CLOCK_STEP_MAX_LAG		60		// Behind by more than this: fast sync (servo)
+#define CLOCK_DAY_FIX_STROKES	2		// Extra servo strokes to find a missing 23→00 edge
+
 
 #endif /* _CLOCK_TASK_H_ */
@@ -26,6 +26,47 @@ void displayTask(void *parameters);
 #define DISPLAY_CLOCK_INTERVAL	500
 #define DISPLAY_TASK_DELAY		20		// Frequency Display update Task
 
+// OLED power policy: contrast steps by time of day, charge pump off while the display is off
+#define DISPLAY_CONTRAST_DAY		0xFF
+#define DISPLAY_CONTRAST_EVENING	0x60
+#define DISPLAY_CONTRAST_NIGHT		0x10	// Inside the silent period
+#define DISPLAY_DAY_START			7		// First hour at day contrast
+#define DISPLAY_DAY_END				20		// First hour at evening contrast
+
+// OLED current model (uA, clock face lit; SSD1306 datasheet typical values)
+#define OLED_ON_CURRENT				600		// Controller and charge pump, panel dark
+#define OLED_PANEL_CURRENT			9000	// Clock face pixels at contrast 0xFF
+#define OLED_SLEEP_CURRENT			10		// Display and charge pump off
+
+// Display bus budgets: upper bounds per render (transactions / payload bytes)
+// Reference costs (one ssd1306_Blit window = 1 / 6 plus SSD1306_BUFF_SIZE data chunks):
+// 9 / 262 per text row, 17 / 518 for the digit band, 3 / 50 for the digit cursor,
+// 33 / 1030 for ssd1306_ClearScreen
+// Worst cases are measured on the host by Test/display_budget_test (every screen and
+// button, both band modes), which prints them next to these bounds
+#define DISPLAY_BUDGET_CLEAR_TX		33		// ssd1306_ClearScreen alone
+#define DISPLAY_BUDGET_CLEAR_BYTES	1030
+#ifdef SSD1306_BAND_BUFFER
+// RAM band: at most 2 / 774 for the digit band and cursor (one window, one burst of the
+// changed columns; nothing when unchanged)
+#define DISPLAY_BUDGET_CLOCK_TX		12		// Clock refresh: contrast, title row, band
+#define DISPLAY_BUDGET_CLOCK_BYTES	1038
+#define DISPLAY_BUDGET_ENTER_TX		60		// Entering a screen: clear, title, content (worst: diagnostic, week)
+#define DISPLAY_BUDGET_ENTER_BYTES	2066	// (worst: time setting)
+#define DISPLAY_BUDGET_EDIT_TX		18		// Button inside a screen (worst: two rows, week or diagnostic)
+#define DISPLAY_BUDGET_EDIT_BYTES	774		// (worst: band redrawn)
+#else
+#define DISPLAY_BUDGET_CLOCK_TX		27		// Clock refresh: contrast, title row, digit band
+#define DISPLAY_BUDGET_CLOCK_BYTES	782
+#define DISPLAY_BUDGET_ENTER_TX		65		// Entering a screen: clear, title, content (worst: setup step,
+#define DISPLAY_BUDGET_ENTER_BYTES	1910	// cursor erased, then the next setting screen)
+#define DISPLAY_BUDGET_EDIT_TX		23		// Button inside a screen (worst: time setting SET, cursor moved and band redrawn)
+#define DISPLAY_BUDGET_EDIT_BYTES	618
+#endif
+#define DISPLAY_BUDGET_MSG_TX		18		// Sync or error message, two rows
+#define DISPLAY_BUDGET_MSG_BYTES	524
+// #define DISPLAY_BUDGET_ASSERT			// Development builds: stop in configASSERT on the first overrun
+
 
 // Display Font Size
 #define DISP_FONT_S 			1
@@ -66,6 +107,18 @@ void displayTask(void *parameters);
 #define DISP_TITLE04					"RTC ADJUST\0"
 #define DISP_TITLE05					"SYNC CLOCK\0"
 #define DISP_TITLE06					"SYNC ERROR\0"
+#define DISP_TITLE07					"DIAGNOSTIC\0"
+#define DISP_TITLE08					"SILENT DAY\0"
+
+// Weekday field of the time setting screen (cursor position after the minutes)
+#define SET_RTC_WEEKDAY			4
+
+// Diagnostic screen (two items per page, "LBL nnnnnn" rows)
+#define DIAG_ITEMS_PER_PAGE		2
+#define DIAG_PAGES				((DIAG_ITEMS + DIAG_ITEMS_PER_PAGE - 1) / DIAG_ITEMS_PER_PAGE)	// Last page may be partial
+#define DIAG_VALUE_DIGITS		6
+#define DIAG_VALUE_MAX			999999
+#define DIAG_VALUE_NEG_MAX		99999		// One digit column less, for the minus sign
 
 
 
@@ -78,6 +131,36 @@ enum dispStateEnum{
 	DISP_SET_CORRECTION,
 	DISP_SYNC,
 	DISP_ERROR,
+	DISP_DIAG,
+	DISP_SET_WEEK,
+};
+
+// Diagnostic item enumerator (order matches label array)
+enum diagItemEnum{
+	DIAG_UPTIME,
+	DIAG_RESYNCS,
+	DIAG_COIL_PULSES,
+	DIAG_SERVO_STROKES,
+	DIAG_FLIP_OFFSET,
+	DIAG_CALIBRATION,
+	DIAG_RENDER_TIME,
+	DIAG_STACK_DISPLAY,
+	DIAG_STACK_BUTTON,
+	DIAG_STACK_CLOCK,
+	DIAG_STACK_TIMER,
+	DIAG_CPU_IDLE,
+	DIAG_I2C_LOAD,
+	DIAG_CTX_SWITCHES,
+	DIAG_WAKEUPS,
+	DIAG_SLEEP_TIME,
+	DIAG_CURRENT,
+	DIAG_OLED_CURRENT,
+	DIAG_OLED_WAKE_CMD,
+	DIAG_BUS_OVER,
+	DIAG_BUS_LAST,
+	DIAG_I2C_ERRORS,
+	DIAG_REINITS,
+	DIAG_ITEMS
 };
 
 // Digit selection enumerator
@@ -88,20 +171,63 @@ enum setTimeEnum{
 	UNIT_MINS
 };
 
+// Display bus budget enumerator (order matches displayBudget[])
+enum displayBudgetEnum{
+	DISP_BUDGET_CLEAR,
+	DISP_BUDGET_CLOCK,
+	DISP_BUDGET_ENTER,
+	DISP_BUDGET_EDIT,
+	DISP_BUDGET_MSG,
+	DISP_BUDGETS
+};
+
+// Display bus budget of one render
+typedef struct {
+	uint16_t transactions;
+	uint16_t bytes;
+} displayBudget_t;
+
+extern const displayBudget_t displayBudget[DISP_BUDGETS];	// Indexed by displayBudgetEnum
+
 enum onOffEnum{
 	OFF,
 	ON,
 };
 
+// Digit band and cursor: composed in the driver RAM band and sent once per render
+// (SSD1306_BAND_BUFFER), or written to the panel window by window
+#ifdef SSD1306_BAND_BUFFER
+#define displayBandBlit			ssd1306_BandBlit
+#define displayBandFlush()		ssd1306_BandFlush()
+#else
+#define displayBandBlit			ssd1306_Blit
+#define displayBandFlush()
+#endif
+
+// Characters at free X positions, rendered in one window (displayGenGlyphs)
+#define DISP_BAND_CHARS			5
+typedef struct {
+	uint8_t fsize;			// Font size as ssd1306_WriteChar
+	uint8_t x0;				// X of the window's first column
+	uint8_t count;
+	char ch[DISP_BAND_CHARS];
+	uint8_t x[DISP_BAND_CHARS];
+} displayGlyphs_t;
+
 // Display task context (lives on displayTask stack)
 typedef struct {
 	uint8_t state;
 	uint8_t showTime[4];
 	uint8_t digitCursor;
 	uint8_t isOn;
+	uint8_t contrast;		// Contrast last sent to the panel
 	uint8_t setupMode;
+	uint8_t weekDay;		// Weekday being set (DISP_SET_RTC) or edited (DISP_SET_WEEK)
+	uint8_t diagPage;
+	int32_t diagValue[DIAG_ITEMS_PER_PAGE];
 	TickType_t lastOnTime;
 	TickType_t lastClockUpdate;
+	TickType_t lastStatsUpdate;
 } displayCtx_t;
 
 #endif /* _DISPLAY_TASK_H_ */
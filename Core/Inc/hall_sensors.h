@@ -0,0 +1,52 @@
+/**
+ * @file   hall_sensors.h
+ * @brief  Hall sensor (SNS_HOUR, SNS_DAY) edge capture with microsecond
+ *         timestamps.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef _HALL_SENSORS_H_
+#define _HALL_SENSORS_H_
+
+#include "rtos_init.h"
+
+/*
+ *   Hall Sensors Structure and definitions
+ */
+
+// Edge ring buffer (power of two: the index is masked, not divided)
+#define HALL_EDGE_BUF_SIZE		16
+#define HALL_EDGE_BUF_MASK		(HALL_EDGE_BUF_SIZE - 1)
+
+// EXTI priority (below PW_MON, which must preempt everything)
+#define HALL_EXTI_PRIORITY		1
+
+// Sensor selection enumerator
+enum hallSensorEnum{
+	HALL_HOUR,
+	HALL_DAY,
+};
+
+// One captured edge
+typedef struct {
+	uint32_t time;		// Run time counter (us) at the interrupt
+	uint8_t sensor;		// hallSensorEnum
+	uint8_t level;		// Pin level after the edge (0 = falling, 1 = rising)
+} hallEdge_t;
+
+/* EXTI setup and callback (called from main.c) */
+void hallInitEdges(void);
+void hallEdgeCallback(uint16_t GPIO_Pin, uint8_t level);
+
+/* Edge queries (called from clockTask) */
+uint32_t hallEdgeMark(void);
+uint8_t hallEdgeFirst(uint32_t mark, uint8_t sensor, hallEdge_t *edge);
+
+#endif /* _HALL_SENSORS_H_ */
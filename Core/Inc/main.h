@@ -93,6 +93,14 @@ void Error_Handler(void);
 //#define CIFRA5_DEBUG
 #define ERROR_HANDLER_FLASH_DELAY	200000UL
 
+// Run time statistics time base (free-running 32-bit timer, 1 MHz)
+#define STATS_TIMER					TIM2
+#define STATS_TIMER_HZ				1000000UL
+
+// Coil drive PWM (TIM3 CH1 = CLK_TICK PA6, CH2 = CLK_TOCK PA7, AF1)
+#define COIL_TIMER					TIM3
+#define COIL_TIMER_HZ				4000000UL
+
 /* USER CODE END Private defines */
 
 #ifdef __cplusplus
@@ -0,0 +1,60 @@
+/**
+ * @file   power_mgr.h
+ * @brief  Silent period power mode: STOP with the end-of-silence alarm and
+ *         the buttons as the only wake sources.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef _POWER_MGR_H_
+#define _POWER_MGR_H_
+
+#include "rtos_init.h"
+#include "rtc_helpers.h"
+#include "time_service.h"
+
+/*
+ *   Power Manager Structure and definitions
+ */
+
+// Button wake EXTI lines (PB3 on EXTI2_3, PB4/PB5 on EXTI4_15)
+#define POWER_WAKE_PINS			(BTN_DEC_Pin | BTN_INC_Pin | BTN_SET_Pin)
+#define POWER_WAKE_PRIORITY		2
+
+// After a button wake, stay awake long enough for buttonTask to report the press
+#define POWER_WAKE_HOLDOFF		2000	// ms
+
+// Current estimate (MCU only, display off and coil idle; datasheet typical values)
+#define POWER_RUN_CURRENT		1600	// uA, RUN on HSI16 (idle clock level, see sys_clock.h)
+#define POWER_STOP_CURRENT		6		// uA, STOP 1 with the RTC on LSE
+
+// Sleep time is measured on the RTC as a difference of seconds of the week
+#define POWER_WEEK_SECONDS		(SILENT_DAYS * 24UL * 3600UL)
+
+// Wake source enumerator (powerSilentSleep return value)
+enum powerWakeEnum{
+	POWER_WAKE_NONE,		// Did not sleep
+	POWER_WAKE_ALARM,		// End of the silent period (RTC alarm B)
+	POWER_WAKE_BUTTON,		// Button press
+};
+
+/* Sleep entry (called from clockTask) */
+uint8_t powerSilentSleep(const timeSnapshot_t *now);
+
+/* Wake sources (interrupt context, called from main.c) */
+void powerAlarmCallback(void);
+void powerButtonCallback(void);
+
+/* Display state (called from displayTask) */
+void powerSetDisplayOn(uint8_t on);
+
+/* Statistics */
+uint32_t powerCurrentEstimate(void);
+
+#endif /* _POWER_MGR_H_ */
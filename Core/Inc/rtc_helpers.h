@@ -25,35 +25,101 @@
 #define SILENT_DEFAULT_START	22		// Default hour when silent period starts
 #define SILENT_DEFAULT_END		9		// Default hour when silent period ends
 
-// RTC Backup Register allocation
-#define RTC_BKP_MECH_HOURS		RTC_BKP_DR0  // Mechanical clock hours (0-23)
-#define RTC_BKP_MECH_MINUTES	RTC_BKP_DR1  // Mechanical clock minutes (0-59)
-#define RTC_BKP_FLAGS			RTC_BKP_DR2  // Last tick state + other flags
-
-// Backup register flag bits
-#define RTC_BKP_FLAG_LAST_TICK	0x00000001  // Bit 0: last tick state (0=tick, 1=tock)
+// RTC Backup Register allocation (DR1 and DR2 are spare)
+#define RTC_BKP_MECH_STATE		RTC_BKP_DR0  // Mechanism state word, written in one access
+
+// Mechanism state word fields
+#define RTC_BKP_MECH_MINUTES_MASK	0x0000003F  // Bits 5:0: mechanical clock minutes (0-59)
+#define RTC_BKP_MECH_HOURS_MASK		0x00001F00  // Bits 12:8: mechanical clock hours (0-23)
+#define RTC_BKP_MECH_HOURS_SHIFT	8
+#define RTC_BKP_FLAG_LAST_TICK		0x00010000  // Bit 16: last tick state (0=tick, 1=tock)
+#define RTC_BKP_FLAG_POS_VALID		0x00020000  // Bit 17: position is sensor-referenced
+#define RTC_BKP_FLAG_STEP_BUSY		0x00040000  // Bit 18: actuation in flight (position not committed)
+#define RTC_BKP_FLAG_PF_MASK		0x00180000  // Bits 20:19: power-fail record (powerFailEnum)
+#define RTC_BKP_FLAG_PF_SHIFT		19
+#define RTC_BKP_MECH_SEQ_MASK		0xFF000000  // Bits 31:24: sequence tag, bumped on every write
+#define RTC_BKP_MECH_SEQ_SHIFT		24
 
 // Silent hours backup register (start in bits 7:0, end in bits 15:8)
 #define RTC_BKP_SILENT			RTC_BKP_DR3
 
+// Weekly silent schedule (one 24-bit hour map per weekday, Monday first)
+#define SILENT_DAYS				7
+#define SILENT_ALL_DAYS			0				// Record weekday: map applies to every day
+#define SILENT_HOURS_MASK		0x00FFFFFFU
+#define SILENT_DIRTY_ALL		0x01			// Pending all-days record (window applied)
+
 // Calibration backup register (bit 9: plus flag, bits 0-8: value 0-511)
 #define RTC_BKP_CALIB			RTC_BKP_DR4
 
-// Flash settings storage (last page of 64K Flash)
-#define FLASH_SETTINGS_PAGE		31				// Last Flash page (page 31)
-#define FLASH_SETTINGS_ADDR		0x0800F800U		// Page 31 base address
-#define FLASH_SETTINGS_MAGIC	0xC1F5A001U		// Validation magic number
-
-/* Mechanical position (backup registers DR0/DR1) */
+// Sub-second counter width: log2(SynchPrediv + 1), SynchPrediv = 255 in MX_RTC_Init
+#define RTC_SUBSEC_BITS			8
+
+// Flash settings storage (last two pages of 64K Flash, A/B slots)
+#define FLASH_SETTINGS_PAGE		30				// First settings page (slot A = 30, slot B = 31)
+#define FLASH_SETTINGS_PAGES	2
+#define FLASH_SETTINGS_ADDR		0x0800F000U		// Page 30 base address (SETTINGS region)
+#define FLASH_PAGE_NONE			0xFF			// No valid slot found
+
+// Single-record layout of older firmware (page 31, no header, no CRC)
+#define FLASH_LEGACY_ADDR		0x0800F800U
+#define FLASH_LEGACY_MAGIC		0xC1F5A001U
+
+// Flash log records: double-words appended to the active slot, slot 0 of a
+// page is its header. word1 = tag | CRC-8 | record type, word0 = payload
+#define FLASH_LOG_RECORDS		(FLASH_PAGE_SIZE / 8)	// 256 records per page (header included)
+#define FLASH_LOG_TAG			0xC1F50000U		// Record tag (word1 bits 31:16)
+#define FLASH_LOG_TAG_MASK		0xFFFF0000U
+#define FLASH_LOG_ERASED		0xFFFFFFFFU		// Erased Flash word
+#define FLASH_CRC8_POLY			0x07			// CRC-8 (ATM) over payload and type
+
+// Flash log payload helpers
+#define FLASH_LOG_TIME(h,m)		(((uint32_t)(h) << 8) | (uint32_t)(m))	// hh:mm in 16 bits
+#define FLASH_LOG_COLD_BOOT		0x00010000U		// Power up record: RTC lost (battery removed)
+#define FLASH_LOG_PF_SHIFT		17				// Power up record: powerFailEnum in bits 18:17
+#define FLASH_SILENT_DAY_SHIFT	24				// Silent day record: weekday in bits 26:24
+
+// Deferred settings write (coalescing window of the timer daemon)
+#define FLASH_WRITE_DELAY		3000
+#define FLASH_LOG_QUEUE_WAIT	100				// Event record: max wait (ms) for a free timer command slot
+
+// Power-fail handler outcome (state word bits 20:19)
+enum powerFailEnum{
+	PF_NOT_DETECTED,		// Previous run ended without the PW_MON interrupt
+	PF_NO_STEP,				// Power fail while idle
+	PF_STEP_COMMITTED,		// Step far enough to have moved the flap, counted
+	PF_STEP_ROLLED_BACK,	// Step cut short, position left unchanged
+};
+
+// Flash log record types (word1 bits 7:0)
+enum flashRecEnum{
+	FLASH_REC_SETTINGS = 0x01,	// silentStart[7:0] | silentEnd[15:8] | calibRaw[25:16]
+	FLASH_REC_RESYNC = 0x02,	// RTC hh:mm[15:0] | mechanical hh:mm[31:16] at drift detection
+	FLASH_REC_POWER_UP = 0x03,	// RTC hh:mm[15:0] | FLASH_LOG_COLD_BOOT | powerFailEnum[18:17]
+	FLASH_REC_HEADER = 0x04,	// Page sequence number (slot 0 of each page)
+	FLASH_REC_SILENT_DAY = 0x05,	// hour map[23:0] | weekday[26:24] (SILENT_ALL_DAYS = every day)
+};
+
+/* Mechanical position (backup register DR0, cached in RAM) */
 uint8_t getMechHours(void);
 uint8_t getMechMinutes(void);
 void incrementMechMinute(void);
 void incrementMechHour(void);
 void resetMechPosition(void);
+void markMechZero(void);
+void correctMechPosition(uint8_t hours, uint8_t minutes);
+
+/* Mechanical position journal (DR0 bits 17-18) */
+uint8_t isMechPositionValid(void);
+void beginMechStep(void);
+void rollbackMechStep(void);
+
+/* Power-fail record (DR0 bits 19-20) */
+void setPowerFailRecord(uint8_t outcome);
+uint8_t takePowerFailRecord(void);
 
-/* Tick/tock alternation (backup register DR2 bit 0) */
+/* Tick/tock alternation (DR0 bit 16, flipped by incrementMechMinute) */
 uint8_t getLastTick(void);
-void setLastTick(uint8_t tickState);
 
 /* Silent period hours (backup register DR3, packed) */
 uint8_t getSilentStartHour(void);
@@ -65,11 +131,47 @@ void getCalibration(uint8_t *plusPulses, uint16_t *calibValue);
 void setCalibration(uint8_t plusPulses, uint16_t calibValue);
 void applyCalibration(void);
 
-/* Flash settings persistence (page 31) */
+/* Flash settings persistence and event log (pages 30-31) */
 void flashWriteSettings(void);
 void flashRestoreSettings(void);
+void flashSettingsTimerInit(void);
+void flashScheduleSettings(void);
+void flashLogEvent(uint8_t type, uint32_t payload);
+uint16_t flashLogCount(void);
+uint8_t flashLogRead(uint16_t index, uint8_t *type, uint32_t *payload);
+
+/* Weekly silent schedule (7x24 hour bitmap in RAM, day records in Flash) */
+void silentScheduleInit(void);
+void silentApplyWindow(void);
+uint32_t getSilentDayMap(uint8_t weekDay);
+void setSilentDayHour(uint8_t weekDay, uint8_t hour, uint8_t silent);
 
 /* Silent period check */
+uint8_t isSilentAt(uint8_t weekDay, uint8_t hours, uint8_t minutes);
 uint8_t isInSilentPeriod(void);
 
+/* Sub-second time */
+uint16_t rtcMsToNextMinute(void);
+
+/*
+ *   Decimal helpers: the Cortex-M0+ has no divide instruction, so a / 10
+ *   becomes a call to __aeabi_uidiv. The RTC already counts in BCD and
+ *   these cover the few places that still need a binary value.
+ */
+
+// Packed BCD byte (RTC_FORMAT_BCD) to binary, multiply only
+static inline uint8_t bcdToBin(uint8_t bcd) {
+	return (uint8_t)((bcd >> 4) * 10 + (bcd & 0x0F));
+}
+
+// Exact n / 10 for any 32-bit value with shifts and adds (Hacker's Delight)
+static inline uint32_t divu10(uint32_t n) {
+	uint32_t q = (n >> 1) + (n >> 2);
+	q += q >> 4;
+	q += q >> 8;
+	q += q >> 16;
+	q >>= 3;
+	return q + (((n - q * 10) + 6) >> 4);
+}
+
 #endif /* _RTC_HELPERS_H_ */
@@ -35,6 +35,7 @@ enum dispEventIdEnum{
 	DISP_EV_BTN_SET_LONG = 104,
 	DISP_EV_BTN_INC_LONG = 105,
 	DISP_EV_BTN_DEC_LONG = 106,
+	DISP_EV_BTN_CHORD = 107,
 	DISP_EV_SYN_START = 201,
 	DISP_EV_SYN_SRC_HOUR = 202,
 	DISP_EV_SYN_SRC_DAY = 203,
@@ -49,15 +50,13 @@ enum dispEventIdEnum{
 };
 
 /*
- *  Shared global variables (defined in rtos_init.c and rtc_helpers.c)
+ *  Shared global variables (defined in rtos_init.c)
  */
 extern TIM_HandleTypeDef *htimHandle;
 extern RTC_HandleTypeDef *hrtcHandle;
 extern TaskHandle_t displayTaskHandle;
 extern TaskHandle_t buttonTaskHandle;
 extern TaskHandle_t clockTaskHandle;
-extern RTC_TimeTypeDef RTC_Time;
-extern RTC_DateTypeDef RTC_Date;
 
 
 /*
@@ -51,6 +51,9 @@ void HardFault_Handler(void);
 void EXTI0_1_IRQHandler(void);
 void TIM17_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void EXTI2_3_IRQHandler(void);
+void EXTI4_15_IRQHandler(void);
+void RTC_TAMP_IRQHandler(void);
 
 /* USER CODE END EFP */
 
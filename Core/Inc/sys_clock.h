@@ -0,0 +1,48 @@
+/**
+ * @file   sys_clock.h
+ * @brief  System clock scaling: HSI16 while idle, PLL 64 MHz for display
+ *         rendering and servo strokes.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef _SYS_CLOCK_H_
+#define _SYS_CLOCK_H_
+
+#include "rtos_init.h"
+
+/*
+ *   System Clock Structure and definitions
+ */
+
+// Timer clocks kept constant at both levels (prescalers follow SystemCoreClock)
+#define SYSCLK_SERVO_TIMER_HZ	50000UL		// TIM1: 1000 counts = 20 ms servo frame
+
+// SysTick one-off reload after a switch: floor, so the reload is seen before the next wrap
+#define SYSCLK_TICK_MIN_REMAIN	16
+
+// Flash wait states per level (RM0444: 0 WS up to 24 MHz, 2 WS up to 64 MHz)
+#define SYSCLK_IDLE_LATENCY		FLASH_LATENCY_0
+#define SYSCLK_FAST_LATENCY		FLASH_LATENCY_2
+
+// Clock users (bit mask: the PLL runs while any of them holds it)
+enum sysClockUserEnum{
+	SYSCLK_USER_DISPLAY = 0x01,		// Display rendering burst
+	SYSCLK_USER_SERVO = 0x02,		// Servo PWM running (TIM1 must not be rescaled mid-frame)
+};
+
+/* Level control (task context) */
+void sysClockInit(void);
+void sysClockBoost(uint8_t user);
+void sysClockRelease(uint8_t user);
+
+/* Restore the current level after a wake from STOP (scheduler suspended) */
+void sysClockResume(void);
+
+#endif /* _SYS_CLOCK_H_ */
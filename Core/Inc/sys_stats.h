@@ -0,0 +1,81 @@
+/**
+ * @file   sys_stats.h
+ * @brief  Run time statistics: per-task CPU load, context switches and
+ *         display bus occupancy.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef _SYS_STATS_H_
+#define _SYS_STATS_H_
+
+#include "rtos_init.h"
+
+/*
+ *   System Statistics Structure and definitions
+ */
+
+// Sampling window
+#define STATS_UPDATE_INTERVAL	1000	// CPU load window in ms
+
+// Task selection enumerator (index into sysStats_t.cpuLoad[])
+enum statsTaskEnum{
+	STATS_TASK_DISPLAY,
+	STATS_TASK_BUTTON,
+	STATS_TASK_CLOCK,
+	STATS_TASK_IDLE,
+	STATS_TASK_MAX
+};
+
+// Statistics snapshot (refreshed by statsUpdate, readable from the debugger)
+typedef struct {
+	uint32_t windowTime;				// Length of the last window in us
+	uint8_t cpuLoad[STATS_TASK_MAX];	// CPU share per task in the last window (%)
+	uint32_t ctxSwitches;				// Context switches in the last window
+	uint32_t ctxSwitchesTotal;			// Context switches since boot
+	uint32_t i2cBusyTime;				// Display bus busy time in the last window (us)
+	uint8_t i2cLoad;					// Display bus occupancy in the last window (%)
+	uint32_t i2cTransactions;			// Display bus transactions since boot
+	uint32_t i2cBytes;					// Display bus payload bytes since boot
+	uint32_t i2cErrors;					// Display bus failed attempts (each one recovered and retried) since boot
+	uint32_t i2cFailures;				// Display bus writes given up since boot
+	uint32_t displayReinits;			// Display re-initializations after bus faults since boot
+	uint32_t uptime;					// Seconds since boot
+	uint32_t resyncs;					// Drift resynchronizations since boot
+	uint32_t coilPulses;				// Minute coil pulses since boot
+	uint32_t servoStrokes;				// Hour servo strokes since boot
+	uint32_t dayCorrections;			// Hour drum corrections from SNS_DAY since boot
+	uint32_t hourEdgeDelay;				// Last coil energize to SNS_HOUR edge (us)
+	uint32_t dayEdgeDelay;				// Last servo engage to SNS_DAY edge (us)
+	uint32_t flipLatency;				// Filtered coil energize to flap landing (us)
+	int32_t flipOffset;					// Last pre-fired flap landing vs :00 (ms, + = late)
+	uint32_t renderTimeMax;				// Worst display render time in us
+	uint32_t wakeups;					// Exits from STOP since boot
+	uint32_t sleepTime;					// Seconds spent in STOP since boot (RTC)
+	uint32_t currentEstimate;			// Estimated average MCU current (uA)
+	uint32_t clockSwitches;				// System clock level changes since boot
+	uint32_t oledOnTime;				// Seconds with the display on since boot
+	uint32_t oledContrastTime;			// Contrast x seconds with the display on since boot
+	uint32_t oledWakeCmdTime;			// Bus time of the last display wake command (us, charge pump ramp not included)
+	uint32_t busBudgetOver;				// Display renders over their bus budget since boot
+	uint8_t busBudgetLast;				// Budget of the last overrun (displayBudgetEnum)
+	uint32_t busRenderTx;				// Bus transactions of the last measured render
+} sysStats_t;
+
+extern sysStats_t sysStats;
+
+/* Run time counter (called by the FreeRTOS kernel, see FreeRTOSConfig.h) */
+void statsInitTimer(void);
+uint32_t statsGetCounter(void);
+
+/* Statistics window refresh */
+void statsUpdate(void);
+void statsRenderTime(uint32_t start);
+
+#endif /* _SYS_STATS_H_ */
@@ -0,0 +1,47 @@
+/**
+ * @file   time_service.h
+ * @brief  Shared RTC time snapshot, published once per second and read
+ *         lock-free by every task.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef _TIME_SERVICE_H_
+#define _TIME_SERVICE_H_
+
+#include "rtos_init.h"
+
+/*
+ *   Time Service Structure and definitions
+ */
+
+// RTC alarm priority (below PW_MON and the hall sensor edges)
+#define TIME_ALARM_PRIORITY		2
+
+// Published time (all fields from the same RTC read)
+typedef struct {
+	uint8_t hours;			// 0-23
+	uint8_t minutes;		// 0-59
+	uint8_t seconds;		// 0-59
+	uint8_t weekDay;		// RTC_WEEKDAY_MONDAY (1) - RTC_WEEKDAY_SUNDAY (7)
+	uint8_t digits[4];		// [tensHrs, unitsHrs, tensMins, unitsMins]
+	uint8_t silent;			// 1 = inside the silent period
+} timeSnapshot_t;
+
+/* Publisher (RTC alarm A every second, or on demand after a time change) */
+void timeServiceInit(void);
+void timeServicePublish(void);
+void timeServiceAlarmCallback(void);
+void timeServiceSuspend(void);
+void timeServiceResume(void);
+
+/* Consumers */
+uint32_t timeGetSnapshot(timeSnapshot_t *snap);
+
+#endif /* _TIME_SERVICE_H_ */
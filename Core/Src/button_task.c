@@ -24,7 +24,11 @@
  *
  *         Button protocol:
  *         - Buttons are active-low (pressed=0, released=1)
- *         - Only one button can be held at a time (multi-press rejected)
+ *         - Only one button can be held at a time (multi-press rejected),
+ *           except the INC+DEC chord: pressing the second one while the
+ *           first is held sends DISP_EV_BTN_CHORD (107) instead; both
+ *           buttons are then recorded as pressed and their releases are
+ *           swallowed, in either order, until the keypad is idle again
  *         - Short press: fires on RELEASE if held < BTN_LONG_PRESS_TIME (1s)
  *           → sends notification 101+i (DISP_EV_BTN_SET/INC/DEC)
  *         - Long press: fires while HOLDING after BTN_LONG_PRESS_TIME elapsed
@@ -90,6 +94,13 @@ void buttonTask(void *parameters) {
 							heldButton = i;
 							pressTime = xTaskGetTickCount();
 							longPressSent = 0;
+						} else if (!longPressSent
+								&& (((heldButton == BTN_INC) && (i == BTN_DEC))
+								|| ((heldButton == BTN_DEC) && (i == BTN_INC)))) {  // INC+DEC chord
+							tactButton[i].status = tactButton[i].actual;  // Second button held too: no fresh press later
+							longPressSent = 1;  // Swallow both releases
+							xTaskNotify(displayTaskHandle, (uint32_t) DISP_EV_BTN_CHORD, eSetValueWithOverwrite);
+							vTaskSuspend(NULL);
 						}
 					} else {  // Button released (logic high)
 						tactButton[i].status = tactButton[i].actual;
@@ -14,6 +14,82 @@
 #include "rtos_init.h"
 #include "rtc_helpers.h"
 #include "clock_task.h"
+#include "sys_stats.h"
+#include "hall_sensors.h"
+#include "time_service.h"
+#include "power_mgr.h"
+#include "sys_clock.h"
+
+
+// Actuation in progress and its start tick, read by clockPowerFail() (ISR)
+static volatile uint8_t stepType = STEP_NONE;
+static volatile TickType_t stepStart;
+static uint32_t stepStartUs;		// Same instant on the run time counter (us)
+
+// Filtered coil energize to flap landing latency, used to pre-fire the minute flip (us)
+static uint32_t flipLatencyUs = COIL_FLIP_LATENCY * 1000;
+static uint16_t flipLatencyMs = COIL_FLIP_LATENCY;	// Same in ms, converted once per update
+
+
+/**
+ * @brief  Check whether a sensor made a given transition after a mark.
+ *
+ *         Replaces the level sampling before/after each actuation: the
+ *         edges are captured by EXTI (hall_sensors.c), so a bouncing or
+ *         short magnet pass is still seen, and its time is known.
+ *
+ * @param  mark    Edge stream mark taken before the actuation
+ * @param  sensor  Sensor (hallSensorEnum)
+ * @param  level   Level the transition leads to (1 = 0→1, 0 = 1→0)
+ * @return 1 if the first edge of the sensor after the mark goes to level
+ */
+static uint8_t sensorCrossed(uint32_t mark, uint8_t sensor, uint8_t level) {
+	hallEdge_t edge;
+	return (hallEdgeFirst(mark, sensor, &edge) && (edge.level == level)) ? 1 : 0;
+}
+
+
+/**
+ * @brief  Drive the coil pins from TIM3 PWM (CLK_TICK = CH1, CLK_TOCK = CH2).
+ *
+ *         Called from MX_GPIO_Init() (USER CODE section) after the pins have
+ *         been configured as plain outputs. A pin low drives the coil (the
+ *         other pin stays high), both high leave it idle, so the channels
+ *         are active low in PWM mode 1:
+ *         - CCR = COIL_CCR_FULL: always low, full drive (pull-in)
+ *         - CCR = COIL_CCR_HOLD: low for COIL_HOLD_DUTY of each period, the
+ *           driver recirculates the coil current in between (hold)
+ *         - CCR = 0: always high, coil off
+ *         The compare registers are not preloaded, so a new duty applies at
+ *         once (clockPowerFail relies on it).
+ *
+ *         The timer is programmed at register level like TIM2 (no interrupt,
+ *         no HAL handle); sysClockRescale() keeps COIL_TIMER_HZ when the
+ *         system clock changes.
+ *
+ */
+void coilInitPwm(void) {
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	__HAL_RCC_TIM3_CLK_ENABLE();
+	COIL_TIMER->CR1 = 0;
+	COIL_TIMER->PSC = (SystemCoreClock / COIL_TIMER_HZ) - 1;
+	COIL_TIMER->ARR = COIL_PWM_PERIOD - 1;
+	COIL_TIMER->CCR1 = 0;
+	COIL_TIMER->CCR2 = 0;
+	COIL_TIMER->CCMR1 = (6U << TIM_CCMR1_OC1M_Pos) | (6U << TIM_CCMR1_OC2M_Pos);	// PWM mode 1
+	COIL_TIMER->CCER = TIM_CCER_CC1E | TIM_CCER_CC1P | TIM_CCER_CC2E | TIM_CCER_CC2P;
+	COIL_TIMER->EGR = TIM_EGR_UG;
+	COIL_TIMER->CR1 = TIM_CR1_ARPE | TIM_CR1_CEN;
+
+	// Outputs are high (coil off) before the pins are handed to the timer
+	GPIO_InitStruct.Pin = CLK_TICK_Pin | CLK_TOCK_Pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+	GPIO_InitStruct.Alternate = GPIO_AF1_TIM3;
+	HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+}
 
 
 /**
@@ -31,12 +107,16 @@
  *         HAL_TIM_PWM_Start(htim, channel): starts PWM output on the
  *         specified timer channel. The duty cycle is set via CCR4 register.
  *
+ *         The fast clock is held until shutdownServo(): a clock change
+ *         rescales TIM1 and would stretch or cut the running servo frame.
+ *
  *         vTaskDelay(ticks): suspends the calling task for the specified
  *         number of ticks, yielding the CPU to other tasks. Unlike a busy
  *         wait, the task consumes no CPU time while delayed.
  *
  */
 static void prepareServo(void) {
+        sysClockBoost(SYSCLK_USER_SERVO);  // No clock change while TIM1 drives the servo
         htimHandle->Instance->CCR4 = 0;
         HAL_TIM_PWM_Start(htimHandle, TIM_CHANNEL_4);
         vTaskDelay(pdMS_TO_TICKS(200));
@@ -50,8 +130,9 @@ static void prepareServo(void) {
  *
  *         Performs one engage→release cycle: pushes the servo arm to the
  *         engage position (SERVO_ENGAGE_PWM) to flip one hour flap, then
- *         returns to the release position. Updates the mechanical hour
- *         counter in backup registers via incrementMechHour().
+ *         returns to the release position. The stroke is journaled with
+ *         beginMechStep() and committed by incrementMechHour(), which
+ *         updates the mechanical hour counter in backup registers.
  *
  *         The servo must be initialized with prepareServo() before calling.
  *         After all hour advances are done, call shutdownServo() to park.
@@ -61,7 +142,13 @@ static void prepareServo(void) {
  *
  */
 static void clockAdvHour(void) {
+	uint32_t mark = hallEdgeMark();
+	hallEdge_t edge;
 
+	beginMechStep();
+	stepStart = xTaskGetTickCount();
+	stepStartUs = statsGetCounter();
+	stepType = STEP_SERVO;
 #ifndef CIFRA5_DEBUG
 	htimHandle->Instance->CCR4 = SERVO_ENGAGE_PWM;
 	vTaskDelay(pdMS_TO_TICKS(SERVO_ENGAGE_TIME));
@@ -69,8 +156,17 @@ static void clockAdvHour(void) {
 	vTaskDelay(pdMS_TO_TICKS(SERVO_ENGAGE_TIME));
 #endif
 
-	// Update mechanical hours in backup registers
+	// Update mechanical hours in backup registers (atomic vs. clockPowerFail)
+	taskENTER_CRITICAL();
 	incrementMechHour();
+	stepType = STEP_NONE;
+	taskEXIT_CRITICAL();
+	sysStats.servoStrokes++;
+
+	// Mechanism timing: when in the stroke the day flap crossed the sensor
+	if (hallEdgeFirst(mark, HALL_DAY, &edge)) {
+		sysStats.dayEdgeDelay = edge.time - stepStartUs;
+	}
 }
 
 /**
@@ -89,29 +185,93 @@ static void shutdownServo(void) {
 	vTaskDelay(pdMS_TO_TICKS(SERVO_PARK_TIME));
 	htimHandle->Instance->CCR4 = 0;
 	HAL_TIM_PWM_Stop(htimHandle, TIM_CHANNEL_4); // Stop to generate PWM signal
+	sysClockRelease(SYSCLK_USER_SERVO);
     vTaskDelay(pdMS_TO_TICKS(500));
 }
 
+/**
+ * @brief  Cross-check the hour drum against SNS_DAY after an hour advance.
+ *
+ *         Called after every servo stroke and every minute step that rolls
+ *         the hour, with the edge stream mark taken before the advance. The
+ *         sensor goes 1→0 exactly at the 23→00 rollover (see
+ *         searchForZeroPosition), so:
+ *         - edge seen, believed hour not 0: the drum is ahead, it is at 00
+ *           → set the hour to 0 in place
+ *         - no edge, believed hour 0: the drum is behind → stroke the servo
+ *           up to CLOCK_DAY_FIX_STROKES times looking for the edge, then set
+ *           the hour to 0; if it never comes the position is reset and the
+ *           next sync searches
+ *         The minute drum is never touched: the minutes are kept as they are.
+ *
+ *         Skipped while the position is not valid (sensor search running).
+ *
+ * @param  mark  Edge stream mark taken before the advance (hallEdgeMark)
+ */
+static void clockCheckDayDrum(uint32_t mark) {
+	uint8_t dayEdge = sensorCrossed(mark, HALL_DAY, 0);
+	uint8_t servoOff, i;
+
+	if (!isMechPositionValid()) {
+		return;
+	}
+
+	if (dayEdge && (getMechHours() != 0)) {
+		correctMechPosition(0, getMechMinutes());
+		sysStats.dayCorrections++;
+	} else if (!dayEdge && (getMechHours() == 0)) {
+		servoOff = (htimHandle->Instance->CCR4 != SERVO_RELEASE_PWM);
+		if (servoOff) {
+			prepareServo();
+		}
+		for (i = 0; i < CLOCK_DAY_FIX_STROKES; i++) {
+			mark = hallEdgeMark();
+			clockAdvHour();
+			if (sensorCrossed(mark, HALL_DAY, 0)) {
+				break;
+			}
+		}
+		if (servoOff) {
+			shutdownServo();
+		}
+		if (i < CLOCK_DAY_FIX_STROKES) {
+			correctMechPosition(0, getMechMinutes());
+			sysStats.dayCorrections++;
+		} else {
+			resetMechPosition();  // Day sensor edge not found: search on next sync
+		}
+	}
+}
+
 /**
  * @brief  Advance the mechanical minute flap by one position using the coil.
  *
  *         The minute mechanism uses an electromagnetic coil that alternates
  *         between two pins (tick/tock) on each advance. The alternation state
- *         is tracked in backup register DR2 bit 0 via getLastTick/setLastTick.
+ *         is tracked in the backup register state word (getLastTick).
  *
- *         Each pulse: drive the coil pin LOW (excite), wait coilExcite ms,
- *         then drive HIGH (release), wait coilRest ms. The slow parameter
+ *         Each pulse: drive the coil pin LOW at full duty for
+ *         COIL_PULLIN_TIME (the flap travels), then at COIL_HOLD_DUTY for the
+ *         rest of coilExcite ms (the flap is held seated), then release it
+ *         HIGH and wait coilRest ms. The hold PWM cuts the energy per step
+ *         and the load on the 24 V boost converter. The slow parameter
  *         adds COIL_EXTRA_TIME to both durations for gentler movement during
  *         normal operation (vs. fast sync).
  *
- *         After the pulse, updates the mechanical minute counter via
- *         incrementMechMinute() and saves the new tick state.
+ *         The pulse is journaled with beginMechStep(); afterwards
+ *         incrementMechMinute() commits the new minute and the flipped tick
+ *         state in a single backup register write. A step that rolls the hour is cross-checked
+ *         against SNS_DAY (clockCheckDayDrum).
  *
- *         HAL_GPIO_WritePin(port, pin, state): directly sets/clears a GPIO
- *         pin. GPIO_PIN_RESET=0 (coil energized), GPIO_PIN_SET=1 (coil off).
+ *         When the flap crosses SNS_HOUR the energize-to-edge delay is a
+ *         direct measure of the flip latency: it feeds a running average
+ *         (weight 1/2^COIL_LATENCY_FILTER) used by clockPreFire().
  *
- *         Guarded by CIFRA5_DEBUG: when defined, skips physical GPIO
- *         toggling but still updates backup registers.
+ *         The pins are TIM3 outputs (coilInitPwm): the drive level is the
+ *         channel compare value, CLK_TICK on CCR1 and CLK_TOCK on CCR2.
+ *
+ *         Guarded by CIFRA5_DEBUG: when defined, skips the physical coil
+ *         drive but still updates backup registers.
  *
  * @param  slow  0 = fast (sync mode), 1 = slow (normal tick with extra delay)
  */
@@ -119,28 +279,97 @@ static void clockAdvMinute(const uint8_t slow) {
 	uint32_t coilExcite = COIL_EXCITE_TIME + (COIL_EXTRA_TIME * slow);
 	uint32_t coilRest = COIL_REST_TIME + (COIL_EXTRA_TIME * slow);
 	uint8_t tickType = getLastTick();
-
-	if (tickType == 0) {
-#ifndef CIFRA5_DEBUG
-			HAL_GPIO_WritePin(CLK_TICK_GPIO_Port, CLK_TICK_Pin, GPIO_PIN_RESET);
-			vTaskDelay(pdMS_TO_TICKS(coilExcite));
-			HAL_GPIO_WritePin(CLK_TICK_GPIO_Port, CLK_TICK_Pin, GPIO_PIN_SET);
-			vTaskDelay(pdMS_TO_TICKS(coilRest));
-#endif
-		tickType = 1;
-	} else {
+	uint32_t mark = hallEdgeMark();
+	hallEdge_t edge;
+	volatile uint32_t *coil = (tickType == 0) ? &COIL_TIMER->CCR1 : &COIL_TIMER->CCR2;
+
+	beginMechStep();
+	stepStart = xTaskGetTickCount();
+	stepStartUs = statsGetCounter();
+	stepType = STEP_COIL;
 #ifndef CIFRA5_DEBUG
-			HAL_GPIO_WritePin(CLK_TOCK_GPIO_Port, CLK_TOCK_Pin, GPIO_PIN_RESET);
-			vTaskDelay(pdMS_TO_TICKS(coilExcite));
-			HAL_GPIO_WritePin(CLK_TOCK_GPIO_Port, CLK_TOCK_Pin, GPIO_PIN_SET);
-			vTaskDelay(pdMS_TO_TICKS(coilRest));
+	*coil = COIL_CCR_FULL;		// Pull-in
+	vTaskDelay(pdMS_TO_TICKS(COIL_PULLIN_TIME));
+	*coil = COIL_CCR_HOLD;		// Hold
+	vTaskDelay(pdMS_TO_TICKS(coilExcite - COIL_PULLIN_TIME));
+	*coil = 0;					// Release
+	vTaskDelay(pdMS_TO_TICKS(coilRest));
+#else
+	(void) coil;
 #endif
-		tickType = 0;
-	}
 
-	// Update mechanical position and tick state in backup registers
+	// Update mechanical position and tick state with one backup register write (atomic vs. clockPowerFail)
+	taskENTER_CRITICAL();
 	incrementMechMinute();
-	setLastTick(tickType);
+	stepType = STEP_NONE;
+	taskEXIT_CRITICAL();
+	sysStats.coilPulses++;
+
+	// Mechanism timing: when in the pulse the minute flap crossed the sensor
+	if (hallEdgeFirst(mark, HALL_HOUR, &edge)) {
+		sysStats.hourEdgeDelay = edge.time - stepStartUs;
+		if (sysStats.hourEdgeDelay < (coilExcite + coilRest) * 1000) {
+			flipLatencyUs += ((int32_t)(sysStats.hourEdgeDelay - flipLatencyUs)) >> COIL_LATENCY_FILTER;
+			sysStats.flipLatency = flipLatencyUs;
+			flipLatencyMs = (uint16_t)(flipLatencyUs / 1000);
+		}
+	}
+
+	if (getMechMinutes() == 0) {
+		clockCheckDayDrum(mark);
+	}
+}
+
+
+/**
+ * @brief  Power-fail handler: stop actuation and settle the position journal.
+ *
+ *         Called from the PW_MON falling edge interrupt (main.c), right
+ *         before the MCU enters SHUTDOWN, so it must fit the supply hold-up
+ *         time: only GPIO, timer and backup register writes.
+ *
+ *         - Releases both coil channels and stops the servo pulses (CCR4 = 0)
+ *         - If a step is in flight, commits it when it was actuated long
+ *           enough to move the flap (COIL_COMMIT_TIME / SERVO_COMMIT_TIME),
+ *           otherwise rolls it back. Either way the journal is left clean,
+ *           so the next boot can fast sync instead of searching
+ *         - Records the outcome in the backup state word; clockTask moves it
+ *           to the Flash log at the next boot
+ *
+ *         The task side commits its steps inside a critical section, so
+ *         this handler never sees a half-committed step.
+ *
+ *         xTaskGetTickCountFromISR(): interrupt-safe read of the tick count.
+ *
+ */
+void clockPowerFail(void) {
+	uint8_t outcome = PF_NO_STEP;
+
+	if ((htimHandle == NULL) || (hrtcHandle == NULL)) {
+		return;  // Power fail before the RTOS modules were initialized
+	}
+
+	COIL_TIMER->CCR1 = 0;	// Both coil pins high (not preloaded: immediate)
+	COIL_TIMER->CCR2 = 0;
+	htimHandle->Instance->CCR4 = 0;
+
+	if (stepType != STEP_NONE) {
+		TickType_t elapsed = xTaskGetTickCountFromISR() - stepStart;
+
+		if ((stepType == STEP_COIL) && (elapsed >= pdMS_TO_TICKS(COIL_COMMIT_TIME))) {
+			incrementMechMinute();
+			outcome = PF_STEP_COMMITTED;
+		} else if ((stepType == STEP_SERVO) && (elapsed >= pdMS_TO_TICKS(SERVO_COMMIT_TIME))) {
+			incrementMechHour();
+			outcome = PF_STEP_COMMITTED;
+		} else {
+			rollbackMechStep();
+			outcome = PF_STEP_ROLLED_BACK;
+		}
+		stepType = STEP_NONE;
+	}
+
+	setPowerFailRecord(outcome);
 }
 
 
@@ -148,18 +377,20 @@ static void clockAdvMinute(const uint8_t slow) {
 /**
  * @brief  Find the mechanical 00:00 position using physical sensors.
  *
- *         Called on first sync when the mechanical position is unknown (both
- *         mech hours and minutes are 0 in backup registers = not yet calibrated).
+ *         Called on sync when the mechanical position is unknown: first boot,
+ *         battery loss, interrupted step or drift (isMechPositionValid() = 0).
  *
  *         Phase 1 — Find 00 minutes:
- *         Advances the minute flap until the hour sensor detects a 0→1
- *         transition (falling edge = magnet leaving sensor). This indicates
- *         the minutes have crossed an hour boundary (XX:00).
+ *         Advances the minute flap until the hour sensor makes a 0→1
+ *         transition during the pulse (falling edge = magnet leaving sensor,
+ *         captured by EXTI). This indicates the minutes have crossed an hour
+ *         boundary (XX:00).
  *         Error after 62 attempts (> 60 minutes = sensor missing).
  *
  *         Phase 2 — Find 00 hours:
  *         Activates the servo, then advances the hour flap until the day
- *         sensor detects a 1→0 transition (rising edge = 24→00 rollover).
+ *         sensor makes a 1→0 transition during the stroke (rising edge =
+ *         24→00 rollover).
  *         Error after 25 attempts (> 24 hours = sensor missing).
  *
  *         On error, notifies displayTask with an error event and suspends.
@@ -172,7 +403,7 @@ static void clockAdvMinute(const uint8_t slow) {
  */
 static void searchForZeroPosition(void) {
 	uint8_t i;
-	uint8_t prevSens;
+	uint32_t mark;
 
 	// Search for 00 minutes using hour sensor
 	xTaskNotify(displayTaskHandle, (uint32_t) DISP_EV_SYN_SRC_HOUR, eSetValueWithOverwrite);
@@ -182,10 +413,10 @@ static void searchForZeroPosition(void) {
 			xTaskNotify(displayTaskHandle, (uint32_t) DISP_EV_ERR_SNS_HOUR, eSetValueWithOverwrite);
 			vTaskSuspend(NULL);
 		}
-		prevSens = HAL_GPIO_ReadPin(SNS_HOUR_GPIO_Port, SNS_HOUR_Pin);
+		mark = hallEdgeMark();
 		clockAdvMinute(0);
 		i++;
-	} while (!((prevSens == 0) && (HAL_GPIO_ReadPin(SNS_HOUR_GPIO_Port, SNS_HOUR_Pin) == 1)));
+	} while (!sensorCrossed(mark, HALL_HOUR, 1));
 
 	// Now at XX:00, search for 00 hours using day sensor
 	xTaskNotify(displayTaskHandle, (uint32_t) DISP_EV_SYN_SRC_DAY, eSetValueWithOverwrite);
@@ -199,13 +430,13 @@ static void searchForZeroPosition(void) {
 			xTaskNotify(displayTaskHandle, (uint32_t) DISP_EV_ERR_SNS_DAY, eSetValueWithOverwrite);
 			vTaskSuspend(NULL);
 		}
-		prevSens = HAL_GPIO_ReadPin(SNS_DAY_GPIO_Port, SNS_DAY_Pin);
+		mark = hallEdgeMark();
 		clockAdvHour();
 		i++;
-	} while (!((prevSens == 1) && (HAL_GPIO_ReadPin(SNS_DAY_GPIO_Port, SNS_DAY_Pin) == 0)));
+	} while (!sensorCrossed(mark, HALL_DAY, 0));
 
-    // Reset mechanical position to 00:00
-    resetMechPosition();
+    // Mechanical position is now a sensor-referenced 00:00
+    markMechZero();
 }
 
 
@@ -219,6 +450,8 @@ static void searchForZeroPosition(void) {
  *
  *         Since hours wrap around 0-23, this handles any direction
  *         (e.g. mechanical=22, target=3 → advances 5 times through 0).
+ *         Each stroke is cross-checked against SNS_DAY; the loop stops if
+ *         the check had to give up on the position.
  *
  * @param  targetHours  Desired hour position (0-23, from RTC)
  */
@@ -229,9 +462,11 @@ static void syncHours(uint8_t targetHours) {
         prepareServo();
     }
 
-	// Advance hours to target (wrap around if needed)
-	while (getMechHours() != targetHours) {
+	// Advance hours to target (wrap around if needed), checking each stroke against SNS_DAY
+	while ((getMechHours() != targetHours) && isMechPositionValid()) {
+		uint32_t mark = hallEdgeMark();
 		clockAdvHour();
+		clockCheckDayDrum(mark);
 	}
 	shutdownServo();
 }
@@ -259,7 +494,7 @@ static void syncMinutes(uint8_t targetMinutes) {
  * @brief  Advance minutes from current position to the next hour boundary (XX:00).
  *
  *         Used in "fast sync" when the mechanical position is known from
- *         backup registers (not 00:00). If minutes are already at 0, does
+ *         backup registers (journal valid). If minutes are already at 0, does
  *         nothing. Otherwise advances (60 - currentMinutes) times to reach
  *         the next hour, which also increments the mechanical hour.
  *
@@ -278,34 +513,145 @@ static void advanceToHourBoundary(void) {
 }
 
 
+/**
+ * @brief  Correct the mechanical position in place after a drift edge.
+ *
+ *         Called when SNS_HOUR shows the 0→1 edge of the XX:00 boundary while
+ *         the backup registers believe the minutes are not 0. The edge proves
+ *         the minute drum is at :00, so only the hour has to be re-derived:
+ *         - believed minutes < 30: the mechanism was behind, the boundary
+ *           just crossed is the one of the believed hour → (H, 0)
+ *         - believed minutes >= 30: the mechanism was ahead, it reached the
+ *           next boundary early → (H+1, 0)
+ *
+ *         The hour drum keeps its known position unless SNS_DAY disagrees:
+ *         its level is 1 at 23 and 0 right after the 23→00 rollover (see
+ *         searchForZeroPosition), so those two hours can be cross-checked.
+ *
+ * @return 1 if the position was corrected, 0 if a full resync is needed
+ */
+static uint8_t correctMinuteDrift(void) {
+	uint8_t hours = getMechHours();
+	uint8_t daySens = HAL_GPIO_ReadPin(SNS_DAY_GPIO_Port, SNS_DAY_Pin);
+
+	if (getMechMinutes() >= 30) {
+		hours = (hours == 23) ? 0 : hours + 1;
+	}
+
+	if (((hours == 0) && (daySens == 1)) || ((hours == 23) && (daySens == 0))) {
+		return 0;  // Hour drum disagrees with the day sensor
+	}
+
+	correctMechPosition(hours, 0);
+	return 1;
+}
+
+
+/**
+ * @brief  Minutes the mechanical clock lags behind the RTC (0-1439).
+ *
+ *         A value close to CLOCK_MINUTES_DAY means the mechanism is ahead.
+ *
+ * @param  now  Time snapshot to compare against
+ * @return Lag in minutes, modulo one day
+ */
+static uint16_t clockLag(const timeSnapshot_t *now) {
+	int16_t lag = ((int16_t)now->hours * 60 + now->minutes)
+			- ((int16_t)getMechHours() * 60 + getMechMinutes());
+	if (lag < 0) {
+		lag += CLOCK_MINUTES_DAY;
+	}
+	return (uint16_t)lag;
+}
+
+
+/**
+ * @brief  Decide whether to fire the next minute flip ahead of :00.
+ *
+ *         Called when the mechanism is in sync with the RTC. Waiting for the
+ *         minute to change would land the flap up to one poll interval plus
+ *         the flip latency late. Instead the time to the next minute is read
+ *         from the RTC sub-second counter (rtcMsToNextMinute) and, once it
+ *         falls within one poll interval of the latency, the task sleeps for
+ *         the difference and returns 1: the caller energizes the coil right
+ *         away and the flap lands on :00.
+ *
+ *         The RTC is read again after the sleep; the landing offset against
+ *         :00 (sign positive when late) goes to sysStats.flipOffset.
+ *
+ *         No flip is pre-fired into the first minute of the silent period.
+ *         For a moment the mechanism is one minute ahead of the RTC, which
+ *         the Phase 3 loop already tolerates (CLOCK_AHEAD_WAIT).
+ *
+ *         vTaskDelay(ticks): blocks the task for the given number of ticks
+ *         (1ms each), the only wait that needs sub-poll resolution here.
+ *
+ * @param  now  Time snapshot the lag was computed from
+ * @return 1 if the minute flip must be fired now, 0 otherwise
+ */
+static uint8_t clockPreFire(const timeSnapshot_t *now) {
+	uint16_t latency = flipLatencyMs;
+	uint16_t toGo = rtcMsToNextMinute();
+	int32_t offset;
+
+	if ((now->minutes == 0) && isSilentAt(now->weekDay, now->hours, 1)) {
+		return 0;  // Next minute starts a silent period
+	}
+	if (toGo > latency + CLOCK_UPDATE_INTERVAL) {
+		return 0;
+	}
+	if (toGo > latency) {
+		vTaskDelay(pdMS_TO_TICKS(toGo - latency));
+	}
+
+	// Positive when still before :00, negative once the minute has rolled
+	toGo = rtcMsToNextMinute();
+	offset = (toGo > 30000) ? (int32_t)toGo - 60000 : (int32_t)toGo;
+	sysStats.flipOffset = (int32_t)latency - offset;
+	return 1;
+}
+
+
 /**
  * @brief  FreeRTOS task: mechanical clock synchronization and minute ticking.
  *
  *         Manages the physical Solari Cifra 5 flip clock mechanism. Runs in
  *         three phases inside an outer while(1) loop:
  *
+ *         At task start a FLASH_REC_POWER_UP record, carrying the outcome of
+ *         the previous power-fail handler, is appended to the Flash log; each drift resync appends a FLASH_REC_RESYNC record.
+ *
  *         PHASE 1 — PRE-SYNC:
  *         On first boot (rtcInitOk=0, RTC never initialized), sends
  *         DISP_EV_FORCE_SETUP to trigger the setup wizard and blocks on
  *         xTaskNotifyWait until the user finishes setting the time.
- *         Then waits out any active silent period (checks every 60s).
+ *         Then waits out any active silent period (in STOP, see below).
  *
  *         PHASE 2 — SYNC:
  *         Suspends buttonTask to prevent user interaction during sync.
- *         If mechanical position is 00:00 (unknown), runs sensor-based
+ *         If the position journal is not valid, runs sensor-based
  *         searchForZeroPosition(). Otherwise does a fast sync via
  *         advanceToHourBoundary(). Then reads RTC time and calls
  *         syncHours() + syncMinutes() to match the mechanical clock.
  *         Notifies displayTask with DISP_EV_SYN_END when complete.
  *
  *         PHASE 3 — NORMAL OPERATION:
- *         Polls every CLOCK_UPDATE_INTERVAL (100ms). Compares mechanical
- *         minutes (from backup registers) to RTC minutes. When they differ,
- *         advances one minute flap using clockAdvMinute(slow=1).
+ *         Polls every CLOCK_UPDATE_INTERVAL (100ms). Computes the lag of the
+ *         mechanical position (from backup registers) behind the RTC. When
+ *         behind, advances one minute flap using clockAdvMinute(slow=1);
+ *         when in sync, clockPreFire() fires the next flip early by the
+ *         measured flip latency so the flap lands on the RTC's :00;
+ *         when ahead by up to CLOCK_AHEAD_WAIT minutes, waits for the RTC;
+ *         when behind by more than CLOCK_STEP_MAX_LAG, breaks to a fast sync.
  *         Monitors the hour sensor during advances — an unexpected hour
- *         transition indicates mechanical drift and triggers a full resync
- *         (breaks back to Phase 2).
+ *         transition indicates mechanical drift: the position is corrected
+ *         in place (correctMinuteDrift) and only the difference is stepped.
+ *         A full resync (breaks back to Phase 2) is left for the case the
+ *         day sensor disagrees with the hour drum.
  *         Also handles silent period entry/exit (exit triggers resync).
+ *         Inside the silent period, with the display off, powerSilentSleep()
+ *         parks every task and keeps the MCU in STOP until the end of the
+ *         period (RTC alarm B) or a button press.
  *
  *         xTaskNotifyWait(clearEntry, clearExit, &value, timeout): blocks
  *         until a notification arrives or timeout. In Phase 1, uses
@@ -322,9 +668,16 @@ static void advanceToHourBoundary(void) {
 void clockTask(void *parameters) {
 	uint8_t rtcInitOk = (uint8_t)(uintptr_t) parameters; // When = 0 the clock has NOT been initialized
 	uint32_t message;
-	uint8_t prevSens;
+	uint32_t mark;
 	uint8_t syncCount = 0;
 	uint8_t inSilentMode = 0;
+	timeSnapshot_t now;
+
+	// Log the power up (every boot follows a main power loss)
+	timeGetSnapshot(&now);
+	flashLogEvent(FLASH_REC_POWER_UP, FLASH_LOG_TIME(now.hours, now.minutes)
+			| (rtcInitOk ? 0 : FLASH_LOG_COLD_BOOT)
+			| ((uint32_t)takePowerFailRecord() << FLASH_LOG_PF_SHIFT));
 
 	while (1) {
 
@@ -338,9 +691,12 @@ void clockTask(void *parameters) {
 			// User finished setting time, proceed to sync
 		}
 
-		// Wait out silent period (power outage recovery)
+		// Wait out silent period (power outage recovery), in STOP when possible
 		while (isInSilentPeriod()) {
-			vTaskDelay(pdMS_TO_TICKS(60000));
+			timeGetSnapshot(&now);
+			if (powerSilentSleep(&now) == POWER_WAKE_NONE) {
+				vTaskDelay(pdMS_TO_TICKS(CLOCK_UPDATE_INTERVAL));
+			}
 		}
 
 		// ===== PHASE 2: SYNC =====
@@ -348,15 +704,11 @@ void clockTask(void *parameters) {
 		vTaskSuspend(buttonTaskHandle); // Disable buttons during sync (no-op if already suspended)
 		vTaskDelay(pdMS_TO_TICKS(200)); // Wait to complete any display action
 
-        if (syncCount == 3) {  // Too many resynchronizations
-			xTaskNotify(displayTaskHandle, (uint32_t) DISP_EV_ERR_MANY_SYNC, eSetValueWithOverwrite);
-		}
-
 		xTaskNotify(displayTaskHandle, (uint32_t) DISP_EV_SYN_START, eSetValueWithOverwrite);
 		vTaskDelay(pdMS_TO_TICKS(1000)); // Wait to show the message on display
 
-		// Check if mechanical position is at 0:0 (first time sync needs sensor search)
-		if (getMechHours() == 0 && getMechMinutes() == 0) {
+		// Unknown mechanical position (journal not valid) needs sensor search
+		if (!isMechPositionValid()) {
 			// FIRST TIME SYNC: Use sensor-based search to find 00:00
 			searchForZeroPosition();
 		} else {
@@ -364,11 +716,10 @@ void clockTask(void *parameters) {
 			advanceToHourBoundary();
 		}
 
-		HAL_RTC_GetTime(hrtcHandle, &RTC_Time, RTC_FORMAT_BIN); // Get updated time
-		HAL_RTC_GetDate(hrtcHandle, &RTC_Date, RTC_FORMAT_BIN);
+		timeGetSnapshot(&now); // Get updated time
 
-		syncHours(RTC_Time.Hours);
-		syncMinutes(RTC_Time.Minutes);
+		syncHours(now.hours);
+		syncMinutes(now.minutes);
 
 		xTaskNotify(displayTaskHandle, (uint32_t) DISP_EV_SYN_END, eSetValueWithOverwrite);
 
@@ -386,8 +737,10 @@ void clockTask(void *parameters) {
 			}
 
 			// Silent period entry
-			if (isInSilentPeriod()) {
+			timeGetSnapshot(&now);
+			if (now.silent) {
 				inSilentMode = 1;
+				powerSilentSleep(&now);  // STOP until the end or a button (display off only)
 				continue;
 			}
 
@@ -397,20 +750,39 @@ void clockTask(void *parameters) {
 				break;
 			}
 
-			// Check if minute advance needed
-			if (RTC_Time.Minutes == getMechMinutes()) {
+			// Check if minute advance needed (in sync, or ahead: wait for the RTC)
+			uint16_t lag = clockLag(&now);
+			if (lag == 0) {
+				if (!clockPreFire(&now)) {
+					continue;  // In sync, next minute not due yet
+				}
+			} else if (lag > (CLOCK_MINUTES_DAY - CLOCK_AHEAD_WAIT)) {
 				continue;
 			}
+			if (lag > CLOCK_STEP_MAX_LAG) {
+				break;  // Far behind: fast sync with the servo
+			}
 
-			prevSens = HAL_GPIO_ReadPin(SNS_HOUR_GPIO_Port, SNS_HOUR_Pin);
+			mark = hallEdgeMark();
 			clockAdvMinute(1);
 
-			// Unexpected hour transition: mechanical drift detected, force full resync
-			if ((prevSens == 0)
-					&& (HAL_GPIO_ReadPin(SNS_HOUR_GPIO_Port, SNS_HOUR_Pin) == 1)
-					&& (getMechMinutes() != 0)) {
-				resetMechPosition();
+			// Unexpected hour transition: mechanical drift detected, correct in place
+			if (sensorCrossed(mark, HALL_HOUR, 1) && (getMechMinutes() != 0)) {
+				flashLogEvent(FLASH_REC_RESYNC, FLASH_LOG_TIME(now.hours, now.minutes)
+						| (FLASH_LOG_TIME(getMechHours(), getMechMinutes()) << 16));
 				syncCount++;
+				sysStats.resyncs++;
+				if (syncCount == 3) {  // Too many resynchronizations (the correction stays in Phase 3)
+					xTaskNotify(displayTaskHandle, (uint32_t) DISP_EV_ERR_MANY_SYNC, eSetValueWithOverwrite);
+				}
+				if (!correctMinuteDrift()) {
+					resetMechPosition();  // Hour drum unknown: full resync
+					break;
+				}
+			}
+
+			// Day sensor check gave up on the hour drum: full resync
+			if (!isMechPositionValid()) {
 				break;
 			}
 		}
@@ -14,8 +14,13 @@
 #include <string.h>
 
 #include "rtos_init.h"
+#include "timers.h"
 #include "rtc_helpers.h"
 #include "display_task.h"
+#include "sys_stats.h"
+#include "time_service.h"
+#include "power_mgr.h"
+#include "sys_clock.h"
 #include "ssd1306.h"
 
 
@@ -33,13 +38,54 @@ const char dispMsg[9][2][11] = {
 };
 
 // Titles array (indexed by dispStateEnum)
-const char dispTitle[6][11] = {
+const char dispTitle[8][11] = {
 		{DISP_TITLE01},
 		{DISP_TITLE02},
 		{DISP_TITLE03},
 		{DISP_TITLE04},
 		{DISP_TITLE05},
 		{DISP_TITLE06},
+		{DISP_TITLE07},
+		{DISP_TITLE08},
+};
+
+// Weekday names (indexed by RTC weekday - 1, Monday first)
+const char dayName[7][4] = {"MON", "TUE", "WED", "THU", "FRI", "SAT", "SUN"};
+
+// Diagnostic labels (indexed by diagItemEnum)
+const char diagLabel[DIAG_ITEMS][4] = {
+		"UPM",		// Uptime in minutes
+		"SYN",		// Drift resynchronizations
+		"COL",		// Minute coil pulses
+		"SRV",		// Hour servo strokes
+		"OFS",		// Last minute flip landing vs :00 (ms, signed)
+		"CAL",		// RTC calibration (signed)
+		"RND",		// Worst display render time (us)
+		"STD",		// displayTask free stack (words)
+		"STB",		// buttonTask free stack (words)
+		"STC",		// clockTask free stack (words)
+		"STT",		// Timer daemon free stack (words, Flash writes)
+		"IDL",		// Idle CPU share (%)
+		"I2C",		// Display bus load (%)
+		"CSW",		// Context switches per second
+		"WAK",		// Exits from STOP
+		"SLP",		// Time spent in STOP in minutes
+		"UA ",		// Estimated average MCU current (uA)
+		"OLU",		// Estimated average OLED current (uA)
+		"OWC",		// Last display wake command time (us)
+		"BOV",		// Renders over their display bus budget
+		"BTX",		// Bus transactions of the last render
+		"I2E",		// Display bus failed attempts (recovered)
+		"DRI",		// Display re-initializations after bus faults
+};
+
+// Display bus budgets (indexed by displayBudgetEnum)
+const displayBudget_t displayBudget[DISP_BUDGETS] = {
+		{DISPLAY_BUDGET_CLEAR_TX, DISPLAY_BUDGET_CLEAR_BYTES},
+		{DISPLAY_BUDGET_CLOCK_TX, DISPLAY_BUDGET_CLOCK_BYTES},
+		{DISPLAY_BUDGET_ENTER_TX, DISPLAY_BUDGET_ENTER_BYTES},
+		{DISPLAY_BUDGET_EDIT_TX, DISPLAY_BUDGET_EDIT_BYTES},
+		{DISPLAY_BUDGET_MSG_TX, DISPLAY_BUDGET_MSG_BYTES},
 };
 
 const uint8_t setTimeDigitPos[4] = { // Array in which is stored the position of the digit same index
@@ -50,27 +96,73 @@ const uint8_t setTimeDigitPos[4] = { // Array in which is stored the position of
 };
 
 
+/**
+ * @brief  Blit generator for a set of characters at free X positions.
+ *
+ *         Called by ssd1306_Blit() for each column of the window. The column
+ *         is blank unless it falls inside a character cell; where two cells
+ *         overlap the later one wins, as it did when the characters were
+ *         written one after the other.
+ *
+ * @param  column  Column inside the window (0 = glyphs->x0)
+ * @param  pages   Pages per column
+ * @param[out] out Column bytes, top page first
+ * @param  arg     Character set (displayGlyphs_t *)
+ */
+static void displayGenGlyphs(uint8_t column, uint8_t pages, uint8_t *out, void *arg) {
+	const displayGlyphs_t *glyphs = arg;
+	uint8_t width = (glyphs->fsize + 1) * SSD1306_CHAR_WIDTH;
+	uint8_t x = glyphs->x0 + column;
+	int8_t cell = -1;
+
+	for (uint8_t i = 0; i < glyphs->count; i++) {
+		if ((x >= glyphs->x[i]) && ((x - glyphs->x[i]) < width)) {
+			cell = i;
+		}
+	}
+	if (cell < 0) {
+		memset(out, 0, pages);
+	} else {
+		ssd1306_GlyphColumn(glyphs->ch[cell], glyphs->fsize, x - glyphs->x[cell], pages, out);
+	}
+}
+
+
+/**
+ * @brief  Render the large digit band (DIGIT_TIME_Y, full width) in one window.
+ *
+ *         The characters are composed column by column by displayGenGlyphs(),
+ *         so the band costs one window command and its data chunks; the
+ *         columns between the characters are cleared on the way. With
+ *         SSD1306_BAND_BUFFER the band is composed in RAM together with the
+ *         cursor and sent by displayBandFlush() at the end of the render.
+ *
+ * @param  ch     Characters (ASCII)
+ * @param  x      X position of each character
+ * @param  count  Number of characters (up to DISP_BAND_CHARS)
+ */
+static void displayShowBand(const char *ch, const uint8_t *x, uint8_t count) {
+	displayGlyphs_t glyphs = {.fsize = DISP_FONT_L, .x0 = 0, .count = count};
+
+	memcpy(glyphs.ch, ch, count);
+	memcpy(glyphs.x, x, count);
+	displayBandBlit(0, DIGIT_TIME_Y, SSD1306_WIDTH, DISP_FONT_L + 1, displayGenGlyphs, &glyphs);
+}
+
+
 /**
  * @brief  Render time as large digits on OLED: HH:MM with colon separator.
  *
- *         Writes each digit at its fixed X position (DIGIT_*_X defines).
+ *         Each digit sits at its fixed X position (DIGIT_*_X defines).
  *         Digit values are raw 0-9, converted to ASCII by adding 48.
  *
  * @param  time  Array of 4 digit values [tensHrs, unitsHrs, tensMins, unitsMins]
  */
 static void displayShowClock(uint8_t *time) {
-	ssd1306_SetCursor(DIGIT_TEEN_HRS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[TEEN_HRS] + 48, DISP_FONT_L);
-	ssd1306_SetCursor(DIGIT_UNIT_HRS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[UNIT_HRS] + 48, DISP_FONT_L);
+	const uint8_t x[5] = {DIGIT_TEEN_HRS_X, DIGIT_UNIT_HRS_X, DIGIT_COLON_X, DIGIT_TEEN_MINS_X, DIGIT_UNIT_MINS_X};
+	char ch[5] = {time[TEEN_HRS] + 48, time[UNIT_HRS] + 48, 58, time[TEEN_MINS] + 48, time[UNIT_MINS] + 48};
 
-	ssd1306_SetCursor(DIGIT_COLON_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(58, DISP_FONT_L);
-
-	ssd1306_SetCursor(DIGIT_TEEN_MINS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[TEEN_MINS] + 48, DISP_FONT_L);
-	ssd1306_SetCursor(DIGIT_UNIT_MINS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[UNIT_MINS] + 48, DISP_FONT_L);
+	displayShowBand(ch, x, 5);
 }
 
 
@@ -83,18 +175,10 @@ static void displayShowClock(uint8_t *time) {
  * @param  time  Array of 4 digit values [tensStart, unitsStart, tensEnd, unitsEnd]
  */
 static void displayShowSilentHours(uint8_t *time) {
-	ssd1306_SetCursor(DIGIT_TEEN_HRS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[0] + 48, DISP_FONT_L);
-	ssd1306_SetCursor(DIGIT_UNIT_HRS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[1] + 48, DISP_FONT_L);
-
-	ssd1306_SetCursor(DIGIT_COLON_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(45, DISP_FONT_L);  // '-' dash
+	const uint8_t x[5] = {DIGIT_TEEN_HRS_X, DIGIT_UNIT_HRS_X, DIGIT_COLON_X, DIGIT_TEEN_MINS_X, DIGIT_UNIT_MINS_X};
+	char ch[5] = {time[0] + 48, time[1] + 48, 45, time[2] + 48, time[3] + 48};  // '-' dash
 
-	ssd1306_SetCursor(DIGIT_TEEN_MINS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[2] + 48, DISP_FONT_L);
-	ssd1306_SetCursor(DIGIT_UNIT_MINS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[3] + 48, DISP_FONT_L);
+	displayShowBand(ch, x, 5);
 }
 
 
@@ -109,42 +193,35 @@ static void displayShowSilentHours(uint8_t *time) {
  * @param  time  Array [plusFlag, hundreds, tens, units]
  */
 static void displayShowCalibration(uint8_t *time) {
-	ssd1306_SetCursor(DIGIT_TEEN_HRS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[0] ? 43 : 45, DISP_FONT_L);  // '+' or '-'
+	const uint8_t x[4] = {DIGIT_TEEN_HRS_X, DIGIT_UNIT_HRS_X, DIGIT_TEEN_MINS_X - 32, DIGIT_UNIT_MINS_X - 32};
+	char ch[4] = {time[0] ? 43 : 45, time[1] + 48, time[2] + 48, time[3] + 48};  // '+' or '-'
 
-	ssd1306_SetCursor(DIGIT_UNIT_HRS_X, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[1] + 48, DISP_FONT_L);
-
-	ssd1306_SetCursor(DIGIT_TEEN_MINS_X - 32, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[2] + 48, DISP_FONT_L);
-	ssd1306_SetCursor(DIGIT_UNIT_MINS_X - 32, DIGIT_TIME_Y);
-	ssd1306_WriteChar(time[3] + 48, DISP_FONT_L);
+	displayShowBand(ch, x, 4);
 }
 
 
 /**
- * @brief  Split current RTC time into individual digit values.
+ * @brief  Copy the current time digits from the time service snapshot.
  *
- *         Reads from the global RTC_Time struct (which must have been
- *         populated by a prior HAL_RTC_GetTime call) and writes the four
- *         digit values into the provided array.
+ *         The digits are precomputed by the publisher (timeGetSnapshot), so
+ *         the display neither reads the RTC nor divides.
  *
  * @param[out] time  Array of 4 digits [tensHrs, unitsHrs, tensMins, unitsMins]
  */
 static void displayUpdateTimeVar(uint8_t *time) {
-	time[TEEN_HRS] = RTC_Time.Hours / 10;
-	time[UNIT_HRS] = RTC_Time.Hours % 10;
-	time[TEEN_MINS] = RTC_Time.Minutes / 10;
-	time[UNIT_MINS] = RTC_Time.Minutes % 10;
+	timeSnapshot_t now;
+	timeGetSnapshot(&now);
+	memcpy(time, now.digits, sizeof(now.digits));
 }
 
 
 /**
  * @brief  Draw or clear the cursor marker above a digit position.
  *
- *         Writes three small characters (symbol) above the digit to form
- *         a visual cursor. Use ASCII 96 (grave accent) to show the cursor, or
- *         ASCII 32 (' ') to erase it when moving to the next digit.
+ *         Draws three overlapping small characters (symbol) above the digit,
+ *         in one window, to form a visual cursor. Use ASCII 96 (grave accent)
+ *         to show the cursor, or ASCII 32 (' ') to erase it when moving to
+ *         the next digit.
  *
  *         In calibration mode, digits 2 and 3 are shifted left by 32 pixels
  *         to match the compact ±NNN layout of displayShowCalibration().
@@ -159,80 +236,160 @@ static void displayCursorSetTime(uint8_t digit, const uint8_t symbol, uint8_t ca
 		xpos -= 32;
 	}
 
-	ssd1306_SetCursor(xpos, DIGIT_TIME_Y - 2);
-	ssd1306_WriteChar(symbol, DISP_FONT_S);
-	ssd1306_SetCursor(xpos + 6, DIGIT_TIME_Y - 2);
-	ssd1306_WriteChar(symbol, DISP_FONT_S);
-	ssd1306_SetCursor(xpos + 10, DIGIT_TIME_Y - 2);
-	ssd1306_WriteChar(symbol, DISP_FONT_S);
+	displayGlyphs_t glyphs = {
+			.fsize = DISP_FONT_S,
+			.x0 = xpos,
+			.count = 3,
+			.ch = {symbol, symbol, symbol},
+			.x = {xpos, xpos + 6, xpos + 10},
+	};
+	displayBandBlit(xpos, DIGIT_TIME_Y - 2, 10 + ((DISP_FONT_S + 1) * SSD1306_CHAR_WIDTH), DISP_FONT_S + 1, displayGenGlyphs, &glyphs);
 }
 
 
 /**
- * @brief  Display a two-line informative message centered on the OLED.
+ * @brief  Write one centered text row (page 0, 3 or 6) on the OLED.
  *
- *         Messages are stored in the dispMsg[9][2][11] array, indexed by msgId.
- *         Each message has two rows of up to 10 characters. The function clears
- *         margin characters on both sides of each row to handle variable-width
- *         centering from previous messages.
+ *         The row is a single full-width window (ssd1306_GenText): the text
+ *         is centered and the columns on both sides are cleared in the same
+ *         transfer, which erases a wider text previously shown on the row.
  *
  *         SSD1306_WIDTH and SSD1306_CHAR_WIDTH are display driver constants
- *         used to compute centered X positions.
+ *         used to compute the centered X position.
+ *
+ * @param  ypos    Page of the row (0 = title, 3 = line 1, 6 = line 2)
+ * @param  buffer  NUL terminated row text (up to 10 characters)
+ */
+static void displayMessageRow(uint8_t ypos, char *buffer) {
+	ssd1306Text_t text = {
+			.text = buffer,
+			.fsize = DISP_FONT_S,
+			.offset = (SSD1306_WIDTH - (SSD1306_CHAR_WIDTH * (DISP_FONT_S + 1) * strlen(buffer))) / 2,
+	};
+	ssd1306_Blit(0, ypos, SSD1306_WIDTH, DISP_FONT_S + 1, ssd1306_GenText, &text);
+}
+
+
+/**
+ * @brief  Display a two-line informative message centered on the OLED.
+ *
+ *         Messages are stored in the dispMsg[9][2][11] array, indexed by msgId.
+ *         Each message has two rows of up to 10 characters, written by
+ *         displayMessageRow().
  *
  * @param  msgId   Index into dispMsg[][] (0-8, derived from event subtraction)
  * @param  buffer  Caller-provided 11-byte char buffer used as scratch for strcpy
  */
 static void displayMessage(uint8_t msgId, char *buffer) {
-
-	// Clear the margins on line 1
-	ssd1306_SetCursor(3, 3);
-	ssd1306_WriteChar(32, DISP_FONT_S);
-	ssd1306_SetCursor(111, 3);
-	ssd1306_WriteChar(32, DISP_FONT_S);
-
-	// Write line 1 message
-	ssd1306_SetCursor((SSD1306_WIDTH - (SSD1306_CHAR_WIDTH * 2 * strlen(dispMsg[msgId][0]))) / 2, 3);
 	strcpy(buffer, dispMsg[msgId][0]);
-	ssd1306_WriteString(buffer, DISP_FONT_S);
-
-	// Clear the margins on line 2
-	ssd1306_SetCursor(3, 6);
-	ssd1306_WriteChar(32, DISP_FONT_S);
-	ssd1306_SetCursor(111, 6);
-	ssd1306_WriteChar(32, DISP_FONT_S);
-
-	// Write line 2 message
-	ssd1306_SetCursor((SSD1306_WIDTH - (SSD1306_CHAR_WIDTH * 2 * strlen(dispMsg[msgId][1]))) / 2, 6);
+	displayMessageRow(3, buffer);
 	strcpy(buffer, dispMsg[msgId][1]);
-	ssd1306_WriteString(buffer, DISP_FONT_S);
+	displayMessageRow(6, buffer);
 }
 
 
 /**
  * @brief  Display a title string centered on the top row (page 0) of the OLED.
  *
- *         Titles are stored in the dispTitle[6][11] array, indexed by the
- *         current display state (dispStateEnum). All titles are 10 characters
- *         wide, so no margin clearing is needed (unlike displayMessage).
+ *         Titles are stored in the dispTitle[8][11] array, indexed by the
+ *         current display state (dispStateEnum), and written as a message
+ *         row (one full-width window).
  *
  * @param  msgId   Index into dispTitle[] (typically ctx.state cast to uint8_t)
  * @param  buffer  Caller-provided 11-byte char buffer used as scratch for strcpy
  */
 static void displayTitle(uint8_t msgId, char *buffer) {
-	// Clear the margins
-	ssd1306_SetCursor((SSD1306_WIDTH - (SSD1306_CHAR_WIDTH * 2 * strlen(dispTitle[msgId]))) / 2, 0);
 	strcpy(buffer, dispTitle[msgId]);
-	ssd1306_WriteString(buffer, DISP_FONT_S);
+	displayMessageRow(0, buffer);
+}
+
+
+/**
+ * @brief  Check the bus traffic of a render against its budget.
+ *
+ *         The driver counters (ssd1306_GetStats) are read at the start of the
+ *         render by the caller and compared here with their current value,
+ *         so the check costs no bus traffic. An overrun is counted in
+ *         sysStats.busBudgetOver with its budget in sysStats.busBudgetLast;
+ *         a change that brings back a full redraw shows up on the diagnostic
+ *         screen (BOV) instead of only as a slower UI. With
+ *         DISPLAY_BUDGET_ASSERT defined it stops in configASSERT instead.
+ *
+ * @param  budget  Budget of the render (displayBudgetEnum)
+ * @param  start   Copy of the driver counters taken before the render
+ */
+static void displayBudgetCheck(uint8_t budget, const ssd1306Stats_t *start) {
+	const ssd1306Stats_t *now = ssd1306_GetStats();
+	uint32_t tx = now->transactions - start->transactions;
+	uint32_t bytes = now->bytes - start->bytes;
+
+	sysStats.busRenderTx = tx;
+	if ((tx > displayBudget[budget].transactions) || (bytes > displayBudget[budget].bytes)) {
+		sysStats.busBudgetOver++;
+		sysStats.busBudgetLast = budget;
+#ifdef DISPLAY_BUDGET_ASSERT
+		configASSERT(0);
+#endif
+	}
+}
+
+
+/**
+ * @brief  Contrast for the current time (display power policy).
+ *
+ *         DISPLAY_CONTRAST_NIGHT inside the silent period, DISPLAY_CONTRAST_DAY
+ *         from DISPLAY_DAY_START to DISPLAY_DAY_END, DISPLAY_CONTRAST_EVENING
+ *         otherwise. The panel current is roughly proportional to the
+ *         contrast, so the night step is also the biggest saving.
+ *
+ * @return Contrast value for ssd1306_SetContrast / ssd1306_Wake
+ */
+static uint8_t displayContrastNow(void) {
+	timeSnapshot_t now;
+
+	timeGetSnapshot(&now);
+	if (now.silent) {
+		return DISPLAY_CONTRAST_NIGHT;
+	}
+	if ((now.hours >= DISPLAY_DAY_START) && (now.hours < DISPLAY_DAY_END)) {
+		return DISPLAY_CONTRAST_DAY;
+	}
+	return DISPLAY_CONTRAST_EVENING;
+}
+
+
+/**
+ * @brief  Follow the contrast policy while the display is on.
+ *
+ *         Called with every clock refresh; the command is only sent when
+ *         the step changes.
+ *
+ * @param  ctx  Display context — reads isOn, reads/writes contrast
+ */
+static void displayUpdateContrast(displayCtx_t *ctx) {
+	uint8_t contrast = displayContrastNow();
+
+	if (ctx->isOn && (contrast != ctx->contrast)) {
+		ssd1306_SetContrast(contrast);
+		ctx->contrast = contrast;
+	}
 }
 
 
 /**
  * @brief  Turn the OLED display on or off, tracking state in the context.
  *
- *         Only sends the hardware command (ssd1306_SetDisplayOnOff) when the
- *         requested state differs from the current state, avoiding redundant
- *         I2C traffic. When turning ON, resets the auto-off timer by updating
- *         ctx->lastOnTime with the current tick count.
+ *         Only sends the hardware commands when the requested state differs
+ *         from the current state, avoiding redundant I2C traffic. OFF is a
+ *         deep sleep (ssd1306_Sleep: display and charge pump off). ON is the
+ *         fast wake (ssd1306_Wake: charge pump, policy contrast and display
+ *         on in one transaction); the panel RAM survived the sleep, so the
+ *         init string and a redraw are not needed. The time of the wake
+ *         command write is kept in sysStats.oledWakeCmdTime; it is not the
+ *         wake latency: the panel lights up only once the charge pump has
+ *         ramped up (about 100 ms after 0x8D 0x14), which is neither waited
+ *         for nor timed. When turning ON, resets the
+ *         auto-off timer by updating ctx->lastOnTime with the current tick count.
  *
  *         xTaskGetTickCount() returns the current RTOS tick count (a
  *         monotonically increasing counter incremented by the SysTick ISR,
@@ -240,12 +397,20 @@ static void displayTitle(uint8_t msgId, char *buffer) {
  *         wake-up for auto-off timeout comparison.
  *
  * @param  newState  ON (1) or OFF (0), from onOffEnum
- * @param  ctx       Display context — reads/writes ctx->isOn, ctx->lastOnTime
+ * @param  ctx       Display context — reads/writes ctx->isOn, ctx->contrast, ctx->lastOnTime
  */
 static void displayOnOff(uint8_t newState, displayCtx_t *ctx) {
 	if (newState != ctx->isOn) {
-		ssd1306_SetDisplayOnOff(newState);
+		if (newState == ON) {
+			uint32_t start = statsGetCounter();
+			ctx->contrast = displayContrastNow();
+			ssd1306_Wake(ctx->contrast);
+			sysStats.oledWakeCmdTime = statsGetCounter() - start;
+		} else {
+			ssd1306_Sleep();
+		}
 		ctx->isOn = newState;
+		powerSetDisplayOn(newState);  // No STOP while the display is on
 	}
 	if (newState == ON) {
 		ctx->lastOnTime = xTaskGetTickCount();
@@ -268,9 +433,13 @@ static void displayOnOff(uint8_t newState, displayCtx_t *ctx) {
  * @param  buf  Caller-provided 11-byte scratch buffer for displayTitle
  */
 static void enterSetRtc(displayCtx_t *ctx, char *buf) {
+	timeSnapshot_t now;
+	timeGetSnapshot(&now);
+
 	ctx->state = DISP_SET_RTC;
 	ctx->setupMode = 0;
 	ctx->digitCursor = 0;
+	ctx->weekDay = ((now.weekDay >= RTC_WEEKDAY_MONDAY) && (now.weekDay <= RTC_WEEKDAY_SUNDAY)) ? now.weekDay : RTC_WEEKDAY_MONDAY;
 	ssd1306_ClearScreen();
 	displayUpdateTimeVar(ctx->showTime);
 	displayTitle(ctx->state, buf);
@@ -296,12 +465,15 @@ static void enterSetRtc(displayCtx_t *ctx, char *buf) {
  * @param  buf  Caller-provided 11-byte scratch buffer for displayTitle
  */
 static void enterSetSilent(displayCtx_t *ctx, char *buf) {
+	uint8_t start = getSilentStartHour();
+	uint8_t end = getSilentEndHour();
+
 	ctx->state = DISP_SET_SILENT;
 	ctx->digitCursor = 0;
-	ctx->showTime[0] = getSilentStartHour() / 10;
-	ctx->showTime[1] = getSilentStartHour() % 10;
-	ctx->showTime[2] = getSilentEndHour() / 10;
-	ctx->showTime[3] = getSilentEndHour() % 10;
+	ctx->showTime[0] = divu10(start);
+	ctx->showTime[1] = start - ctx->showTime[0] * 10;
+	ctx->showTime[2] = divu10(end);
+	ctx->showTime[3] = end - ctx->showTime[2] * 10;
 	ssd1306_ClearScreen();
 	displayTitle(ctx->state, buf);
 	displayShowSilentHours(ctx->showTime);
@@ -327,12 +499,14 @@ static void enterSetCorrection(displayCtx_t *ctx, char *buf) {
 	uint8_t plus;
 	uint16_t val;
 	getCalibration(&plus, &val);
+	uint16_t tens = divu10(val);
+
 	ctx->state = DISP_SET_CORRECTION;
 	ctx->digitCursor = 0;
 	ctx->showTime[0] = plus;
-	ctx->showTime[1] = val / 100;
-	ctx->showTime[2] = (val / 10) % 10;
-	ctx->showTime[3] = val % 10;
+	ctx->showTime[1] = divu10(tens);
+	ctx->showTime[2] = tens - ctx->showTime[1] * 10;
+	ctx->showTime[3] = val - tens * 10;
 	ssd1306_ClearScreen();
 	displayTitle(ctx->state, buf);
 	displayShowCalibration(ctx->showTime);
@@ -340,6 +514,255 @@ static void enterSetCorrection(displayCtx_t *ctx, char *buf) {
 }
 
 
+/**
+ * @brief  Render the weekly schedule editor rows for the current hour.
+ *
+ *         Line 1 shows the weekday and the hour ("  MON 07  "), line 2
+ *         whether that hour is silent. Both rows are full width, so no
+ *         margin clearing is needed.
+ *
+ * @param  ctx  Display context — reads weekDay, digitCursor (hour)
+ * @param  buf  11-byte scratch buffer for the row text
+ */
+static void weekShowHour(displayCtx_t *ctx, char *buf) {
+	uint8_t hour = ctx->digitCursor;
+	uint8_t tens = divu10(hour);
+
+	memcpy(buf, "  ", 2);
+	memcpy(&buf[2], dayName[ctx->weekDay - 1], 3);
+	buf[5] = 32;
+	buf[6] = tens + 48;
+	buf[7] = (hour - tens * 10) + 48;
+	memcpy(&buf[8], "  ", 3);
+	displayMessageRow(3, buf);
+
+	if (getSilentDayMap(ctx->weekDay) & (1UL << hour)) {
+		strcpy(buf, "  SILENT  ");
+	} else {
+		strcpy(buf, " TICKING  ");
+	}
+	displayMessageRow(6, buf);
+}
+
+
+/**
+ * @brief  Enter the weekly silent schedule editor (DISP_SET_WEEK).
+ *
+ *         Reached with a long SET from the HH-HH silent editor. Starts on
+ *         today at the current hour.
+ *
+ * @param  ctx  Display context — sets state, weekDay, digitCursor
+ * @param  buf  Caller-provided 11-byte scratch buffer
+ */
+static void enterSetWeek(displayCtx_t *ctx, char *buf) {
+	timeSnapshot_t now;
+	timeGetSnapshot(&now);
+
+	ctx->state = DISP_SET_WEEK;
+	ctx->weekDay = ((now.weekDay >= RTC_WEEKDAY_MONDAY) && (now.weekDay <= RTC_WEEKDAY_SUNDAY)) ? now.weekDay : RTC_WEEKDAY_MONDAY;
+	ctx->digitCursor = now.hours;
+	ssd1306_ClearScreen();
+	displayTitle(ctx->state, buf);
+	weekShowHour(ctx, buf);
+}
+
+
+/**
+ * @brief  Estimate the average OLED current since boot.
+ *
+ *         Time weighted model: OLED_SLEEP_CURRENT while off (including the
+ *         STOP time of the silent period), OLED_ON_CURRENT plus the panel
+ *         current scaled by the contrast while on. The on time and the
+ *         contrast-seconds are accumulated once per statistics window; the
+ *         shares are taken in per mille to stay in 32 bits.
+ *
+ * @return Estimated average OLED current in uA
+ */
+static uint32_t oledCurrentEstimate(void) {
+	uint32_t scale = (sysStats.uptime + sysStats.sleepTime) / 1000;
+	uint32_t onShare, contrastShare;
+
+	if (scale == 0) {
+		return OLED_ON_CURRENT;
+	}
+	onShare = sysStats.oledOnTime / scale;				// Per mille
+	contrastShare = sysStats.oledContrastTime / scale;	// Per mille x 255 at most
+	return OLED_SLEEP_CURRENT + (((OLED_ON_CURRENT - OLED_SLEEP_CURRENT) * onShare) / 1000)
+			+ ((OLED_PANEL_CURRENT * contrastShare) / (1000UL * 255));
+}
+
+
+/**
+ * @brief  Read the current value of a diagnostic item.
+ *
+ *         Counters and loads come from the sysStats snapshot (refreshed every
+ *         STATS_UPDATE_INTERVAL), the calibration from backup register DR4.
+ *
+ *         uxTaskGetStackHighWaterMark(handle): returns the minimum amount of
+ *         stack (in words) that has remained free since the task started.
+ *         It walks the stack fill pattern, so it is only called here, on the
+ *         diagnostic screen, never in the normal display path.
+ *
+ * @param  item  Item index (diagItemEnum)
+ * @return Item value (signed for the calibration)
+ */
+static int32_t diagGetValue(uint8_t item) {
+	uint8_t plus;
+	uint16_t val;
+
+	switch (item) {
+	case DIAG_UPTIME:        return sysStats.uptime / 60;
+	case DIAG_RESYNCS:       return sysStats.resyncs;
+	case DIAG_COIL_PULSES:   return sysStats.coilPulses;
+	case DIAG_SERVO_STROKES: return sysStats.servoStrokes;
+	case DIAG_FLIP_OFFSET:   return sysStats.flipOffset;
+	case DIAG_CALIBRATION:
+		getCalibration(&plus, &val);
+		return plus ? (int32_t) val : -(int32_t) val;
+	case DIAG_RENDER_TIME:   return sysStats.renderTimeMax;
+	case DIAG_STACK_DISPLAY: return uxTaskGetStackHighWaterMark(displayTaskHandle);
+	case DIAG_STACK_BUTTON:  return uxTaskGetStackHighWaterMark(buttonTaskHandle);
+	case DIAG_STACK_CLOCK:   return uxTaskGetStackHighWaterMark(clockTaskHandle);
+	case DIAG_STACK_TIMER:   return uxTaskGetStackHighWaterMark(xTimerGetTimerDaemonTaskHandle());
+	case DIAG_CPU_IDLE:      return sysStats.cpuLoad[STATS_TASK_IDLE];
+	case DIAG_I2C_LOAD:      return sysStats.i2cLoad;
+	case DIAG_CTX_SWITCHES:  return sysStats.ctxSwitches;
+	case DIAG_WAKEUPS:       return sysStats.wakeups;
+	case DIAG_SLEEP_TIME:    return sysStats.sleepTime / 60;
+	case DIAG_CURRENT:       return powerCurrentEstimate();
+	case DIAG_OLED_CURRENT:  return oledCurrentEstimate();
+	case DIAG_OLED_WAKE_CMD: return sysStats.oledWakeCmdTime;
+	case DIAG_BUS_OVER:      return sysStats.busBudgetOver;
+	case DIAG_BUS_LAST:      return sysStats.busRenderTx;
+	case DIAG_I2C_ERRORS:    return sysStats.i2cErrors;
+	case DIAG_REINITS:       return sysStats.displayReinits;
+	default:                 return 0;
+	}
+}
+
+
+/**
+ * @brief  Format a diagnostic row as "LBL nnnnnn" (exactly 10 characters).
+ *
+ *         The value is right aligned in DIAG_VALUE_DIGITS characters with the
+ *         minus sign in front of the first digit, and saturated to
+ *         DIAG_VALUE_MAX (DIAG_VALUE_NEG_MAX for negatives: the sign takes
+ *         one of the digit columns, never the separator). The fixed width
+ *         lets displayMessageRow() skip the margin clearing.
+ *
+ * @param  item    Item index (diagItemEnum), selects the label
+ * @param  value   Value to print
+ * @param[out] buffer  11-byte buffer receiving the row text
+ */
+static void diagFormatRow(uint8_t item, int32_t value, char *buffer) {
+	uint8_t neg = (value < 0);
+	uint32_t mag = neg ? -value : value;
+	int8_t pos = 9;
+
+	if (mag > (neg ? DIAG_VALUE_NEG_MAX : DIAG_VALUE_MAX)) {
+		mag = neg ? DIAG_VALUE_NEG_MAX : DIAG_VALUE_MAX;
+	}
+
+	memcpy(buffer, diagLabel[item], 3);
+	memset(&buffer[3], 32, 7);
+	buffer[10] = 0;
+
+	do {
+		uint32_t quot = divu10(mag);
+		buffer[pos--] = (mag - quot * 10) + 48;
+		mag = quot;
+	} while (mag);
+	if (neg) {
+		buffer[pos] = 45;  // '-'
+	}
+}
+
+
+/**
+ * @brief  Render the current diagnostic page through displayMessageRow().
+ *
+ *         A row is sent to the display only when its value changed since the
+ *         last render (cached in ctx->diagValue[]), so the once per second
+ *         refresh of a page whose values are steady costs no I2C traffic.
+ *         On a partial last page the rows past DIAG_ITEMS are blanked
+ *         (only on a forced redraw, they never change afterwards).
+ *
+ * @param  ctx    Display context — reads diagPage, reads/writes diagValue[]
+ * @param  buf    11-byte scratch buffer for the row text
+ * @param  force  1 = redraw both rows (page change), 0 = only changed rows
+ */
+static void diagShowPage(displayCtx_t *ctx, char *buf, uint8_t force) {
+	for (uint8_t row = 0; row < DIAG_ITEMS_PER_PAGE; row++) {
+		uint8_t item = (ctx->diagPage * DIAG_ITEMS_PER_PAGE) + row;
+		int32_t value;
+		if (item >= DIAG_ITEMS) {
+			if (force) {
+				buf[0] = 0;
+				displayMessageRow(row ? 6 : 3, buf);
+			}
+			continue;
+		}
+		value = diagGetValue(item);
+		if (force || (value != ctx->diagValue[row])) {
+			ctx->diagValue[row] = value;
+			diagFormatRow(item, value, buf);
+			displayMessageRow(row ? 6 : 3, buf);
+		}
+	}
+}
+
+
+/**
+ * @brief  Enter the hidden diagnostic screen (DISP_DIAG).
+ *
+ *         Reached from DISP_CLOCK with the INC+DEC chord. Shows two items
+ *         per page, INC/DEC scroll the pages and SET returns to the clock.
+ *
+ * @param  ctx  Display context — sets state, diagPage
+ * @param  buf  Caller-provided 11-byte scratch buffer
+ */
+static void enterDiag(displayCtx_t *ctx, char *buf) {
+	ctx->state = DISP_DIAG;
+	ctx->diagPage = 0;
+	ssd1306_ClearScreen();
+	displayTitle(ctx->state, buf);
+	diagShowPage(ctx, buf, 1);
+}
+
+
+/**
+ * @brief  Handle button events in DISP_DIAG state (page scrolling).
+ *
+ *         INC/DEC move to the next/previous page (wrapping), SET or a long
+ *         press of any button returns to DISP_CLOCK.
+ *
+ * @param  eventId  Button event code (101-107)
+ * @param  ctx      Display context — reads/writes diagPage, state
+ * @param  buf      11-byte scratch buffer for display rendering
+ */
+static void handleDiagBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
+	const uint8_t pages = DIAG_PAGES;
+
+	switch (eventId) {
+	case DISP_EV_BTN_INC:
+		ctx->diagPage = (ctx->diagPage + 1) % pages;
+		diagShowPage(ctx, buf, 1);
+		break;
+	case DISP_EV_BTN_DEC:
+		ctx->diagPage = (ctx->diagPage + pages - 1) % pages;
+		diagShowPage(ctx, buf, 1);
+		break;
+	case DISP_EV_BTN_CHORD:
+		break;
+	default:
+		ssd1306_ClearScreen();
+		ctx->state = DISP_CLOCK;
+		ctx->lastClockUpdate = xTaskGetTickCount() - pdMS_TO_TICKS(DISPLAY_CLOCK_INTERVAL) - 10;
+		break;
+	}
+}
+
+
 /**
  * @brief  Handle button events while in DISP_CLOCK (idle) state.
  *
@@ -347,9 +770,10 @@ static void enterSetCorrection(displayCtx_t *ctx, char *buf) {
  *         - Long SET → DISP_SET_RTC (blocked if inside silent period)
  *         - Long INC → DISP_SET_SILENT (edit silent hours)
  *         - Long DEC → DISP_SET_CORRECTION (edit RTC calibration)
+ *         - INC+DEC chord → DISP_DIAG (hidden diagnostic screen)
  *         Short presses are no-ops (display was already woken by caller).
  *
- * @param  eventId  Button event code (101-106)
+ * @param  eventId  Button event code (101-107)
  * @param  ctx      Display context — may transition state
  * @param  buf      11-byte scratch buffer for display rendering
  */
@@ -366,6 +790,9 @@ static void handleClockBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
 	case DISP_EV_BTN_DEC_LONG:
 		enterSetCorrection(ctx, buf);
 		break;
+	case DISP_EV_BTN_CHORD:
+		enterDiag(ctx, buf);
+		break;
 	default:
 		break;
 	}
@@ -375,12 +802,14 @@ static void handleClockBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
 /**
  * @brief  Handle button events in DISP_SET_RTC state (time digit editing).
  *
- *         SET button advances cursor to next digit (0→1→2→3→commit).
+ *         SET button advances cursor to next digit (0→1→2→3→weekday→commit).
  *         INC/DEC buttons modify the digit at the current cursor position
  *         with validation: hours 00-23 (tens 0-2, units clamped to 0-3 when
- *         tens=2), minutes 00-59 (tens 0-5, units 0-9).
+ *         tens=2), minutes 00-59 (tens 0-5, units 0-9). On the weekday field
+ *         (SET_RTC_WEEKDAY, shown in the title row) they cycle MON-SUN; the
+ *         weekly silent schedule depends on it.
  *
- *         When the cursor reaches position 4 (past the last digit):
+ *         When the cursor moves past the weekday:
  *         - Writes the entered time to the RTC via HAL_RTC_SetTime/SetDate
  *           inside a critical section (interrupts disabled to prevent
  *           partial RTC register writes)
@@ -393,16 +822,22 @@ static void handleClockBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
  *         unread notification).
  *
  * @param  eventId  Button event code (101-103 for short presses)
- * @param  ctx      Display context — reads/writes showTime[], digitCursor, state
+ * @param  ctx      Display context — reads/writes showTime[], digitCursor, weekDay, state
+ * @param  buf      11-byte scratch buffer for display rendering
  */
-static void handleSetRtcBtns(uint32_t eventId, displayCtx_t *ctx) {
+static void handleSetRtcBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
 	switch (eventId) {
 	case DISP_EV_BTN_SET:
-		displayCursorSetTime(ctx->digitCursor, 32, 0);
+		if (ctx->digitCursor < SET_RTC_WEEKDAY) {
+			displayCursorSetTime(ctx->digitCursor, 32, 0);
+		}
 		ctx->digitCursor++;
 		break;
 
 	case DISP_EV_BTN_INC:
+		if (ctx->digitCursor == SET_RTC_WEEKDAY) {
+			ctx->weekDay = (ctx->weekDay == RTC_WEEKDAY_SUNDAY) ? RTC_WEEKDAY_MONDAY : ctx->weekDay + 1;
+		}
 		if ((ctx->digitCursor == TEEN_HRS) && (ctx->showTime[ctx->digitCursor] < 2)) {
 			ctx->showTime[ctx->digitCursor]++;
 			if ((ctx->showTime[ctx->digitCursor] == 2) && (ctx->showTime[ctx->digitCursor + 1] > 3)) {
@@ -422,7 +857,9 @@ static void handleSetRtcBtns(uint32_t eventId, displayCtx_t *ctx) {
 		break;
 
 	case DISP_EV_BTN_DEC:
-		if (ctx->showTime[ctx->digitCursor] > 0) {
+		if (ctx->digitCursor == SET_RTC_WEEKDAY) {
+			ctx->weekDay = (ctx->weekDay == RTC_WEEKDAY_MONDAY) ? RTC_WEEKDAY_SUNDAY : ctx->weekDay - 1;
+		} else if (ctx->showTime[ctx->digitCursor] > 0) {
 			ctx->showTime[ctx->digitCursor]--;
 		}
 		break;
@@ -431,20 +868,32 @@ static void handleSetRtcBtns(uint32_t eventId, displayCtx_t *ctx) {
 		break;
 	}
 
-	if (ctx->digitCursor == 4) {
-		// All digits set — update RTC and start sync
-		RTC_Time.Hours = (ctx->showTime[TEEN_HRS] * 10) + ctx->showTime[UNIT_HRS];
-		RTC_Time.Minutes = (ctx->showTime[TEEN_MINS] * 10) + ctx->showTime[UNIT_MINS];
-		RTC_Time.Seconds = 0;
-		RTC_Date.Date = 1;
-		RTC_Date.Month = RTC_MONTH_JANUARY;
-		RTC_Date.Year = 21;
-		RTC_Date.WeekDay = RTC_WEEKDAY_FRIDAY;
+	if (ctx->digitCursor == SET_RTC_WEEKDAY) {
+		// Weekday field: shown in place of the title
+		memcpy(buf, " DAY  ", 6);
+		memcpy(&buf[6], dayName[ctx->weekDay - 1], 3);
+		buf[9] = 32;
+		buf[10] = 0;
+		displayMessageRow(0, buf);
+	} else if (ctx->digitCursor > SET_RTC_WEEKDAY) {
+		// All fields set — update RTC and start sync
+		RTC_TimeTypeDef rtcTime = {0};
+		RTC_DateTypeDef rtcDate = {0};
+
+		// The edited digits are the BCD nibbles the RTC counts in
+		rtcTime.Hours = (ctx->showTime[TEEN_HRS] << 4) | ctx->showTime[UNIT_HRS];
+		rtcTime.Minutes = (ctx->showTime[TEEN_MINS] << 4) | ctx->showTime[UNIT_MINS];
+		rtcTime.Seconds = 0x00;
+		rtcDate.Date = 0x01;
+		rtcDate.Month = RTC_MONTH_JANUARY;
+		rtcDate.Year = 0x21;
+		rtcDate.WeekDay = ctx->weekDay;
 
 		taskENTER_CRITICAL();
-		HAL_RTC_SetTime(hrtcHandle, &RTC_Time, RTC_FORMAT_BIN);
-		HAL_RTC_SetDate(hrtcHandle, &RTC_Date, RTC_FORMAT_BIN);
+		HAL_RTC_SetTime(hrtcHandle, &rtcTime, RTC_FORMAT_BCD);
+		HAL_RTC_SetDate(hrtcHandle, &rtcDate, RTC_FORMAT_BCD);
 		taskEXIT_CRITICAL();
+		timeServicePublish();
 
 		ctx->state = DISP_SYNC;
 		xTaskNotify(clockTaskHandle, (uint32_t) CLOCK_EV_NEW_TIME, eSetValueWithOverwrite);
@@ -462,9 +911,14 @@ static void handleSetRtcBtns(uint32_t eventId, displayCtx_t *ctx) {
  *         as HH-HH. Same digit editing pattern as handleSetRtcBtns but
  *         both pairs are validated as hours (0-23).
  *
+ *         A long SET opens the weekly schedule editor (DISP_SET_WEEK)
+ *         instead, outside the setup wizard.
+ *
  *         On commit (cursor reaches 4):
  *         - Saves start/end hours to backup register DR3 via setSilentHours()
- *         - Persists to Flash via flashWriteSettings()
+ *           and copies the window to every day of the weekly schedule
+ *         - Schedules the Flash write via flashScheduleSettings(), except in
+ *           the setup wizard where the calibration commit schedules it once
  *         - If setupMode=1 (first-boot wizard): chains to enterSetCorrection()
  *         - If setupMode=0 (manual entry): returns to DISP_CLOCK
  *
@@ -474,6 +928,13 @@ static void handleSetRtcBtns(uint32_t eventId, displayCtx_t *ctx) {
  */
 static void handleSetSilentBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
 	switch (eventId) {
+	case DISP_EV_BTN_SET_LONG:
+		if (!ctx->setupMode) {
+			enterSetWeek(ctx, buf);
+			return;
+		}
+		break;
+
 	case DISP_EV_BTN_SET:
 		displayCursorSetTime(ctx->digitCursor, 32, 0);
 		ctx->digitCursor++;
@@ -510,13 +971,14 @@ static void handleSetSilentBtns(uint32_t eventId, displayCtx_t *ctx, char *buf)
 	}
 
 	if (ctx->digitCursor == 4) {
-		// Save to backup registers and persist to Flash
+		// Save to backup registers and persist to Flash (wizard: on calibration commit)
 		setSilentHours(ctx->showTime[0] * 10 + ctx->showTime[1],
 				ctx->showTime[2] * 10 + ctx->showTime[3]);
-		flashWriteSettings();
+		silentApplyWindow();
 		if (ctx->setupMode) {
 			enterSetCorrection(ctx, buf);
 		} else {
+			flashScheduleSettings();
 			ssd1306_ClearScreen();
 			ctx->state = DISP_CLOCK;
 		}
@@ -537,7 +999,8 @@ static void handleSetSilentBtns(uint32_t eventId, displayCtx_t *ctx, char *buf)
  *         On commit (cursor reaches 4):
  *         - Saves to backup register DR4 via setCalibration()
  *         - Applies immediately to RTC hardware via applyCalibration()
- *         - Persists to Flash via flashWriteSettings()
+ *         - Schedules the Flash write via flashScheduleSettings() (deferred,
+ *           also covers the silent hours edited earlier in the wizard)
  *         - If setupMode=1 (first-boot wizard): chains to enterSetRtc()
  *         - If setupMode=0 (manual entry): returns to DISP_CLOCK
  *
@@ -599,7 +1062,7 @@ static void handleSetCorrBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
 		uint16_t value = ctx->showTime[1] * 100 + ctx->showTime[2] * 10 + ctx->showTime[3];
 		setCalibration(ctx->showTime[0], value);
 		applyCalibration();
-		flashWriteSettings();
+		flashScheduleSettings();
 		if (ctx->setupMode) {
 			enterSetRtc(ctx, buf);
 		} else {
@@ -613,6 +1076,105 @@ static void handleSetCorrBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
 }
 
 
+/**
+ * @brief  Handle button events in DISP_SET_WEEK state (weekly schedule).
+ *
+ *         Walks the 7x24 hours one at a time:
+ *         - INC/DEC move to the next/previous hour, crossing into the
+ *           next/previous weekday after 23/before 00
+ *         - SET toggles the silent bit of the shown hour; the change is live
+ *           at once and the Flash write is deferred (flashScheduleSettings)
+ *         - A long press of any button returns to DISP_CLOCK
+ *
+ * @param  eventId  Button event code (101-107)
+ * @param  ctx      Display context — reads/writes weekDay, digitCursor, state
+ * @param  buf      11-byte scratch buffer for display rendering
+ */
+static void handleSetWeekBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
+	switch (eventId) {
+	case DISP_EV_BTN_SET:
+		setSilentDayHour(ctx->weekDay, ctx->digitCursor,
+				!(getSilentDayMap(ctx->weekDay) & (1UL << ctx->digitCursor)));
+		flashScheduleSettings();
+		break;
+
+	case DISP_EV_BTN_INC:
+		if (++ctx->digitCursor > 23) {
+			ctx->digitCursor = 0;
+			ctx->weekDay = (ctx->weekDay == RTC_WEEKDAY_SUNDAY) ? RTC_WEEKDAY_MONDAY : ctx->weekDay + 1;
+		}
+		break;
+
+	case DISP_EV_BTN_DEC:
+		if (ctx->digitCursor-- == 0) {
+			ctx->digitCursor = 23;
+			ctx->weekDay = (ctx->weekDay == RTC_WEEKDAY_MONDAY) ? RTC_WEEKDAY_SUNDAY : ctx->weekDay - 1;
+		}
+		break;
+
+	case DISP_EV_BTN_CHORD:
+		return;
+
+	default:
+		ssd1306_ClearScreen();
+		ctx->state = DISP_CLOCK;
+		ctx->lastClockUpdate = xTaskGetTickCount() - pdMS_TO_TICKS(DISPLAY_CLOCK_INTERVAL) - 10;
+		return;
+	}
+
+	weekShowHour(ctx, buf);
+}
+
+
+/**
+ * @brief  Bring the display back after display bus faults.
+ *
+ *         Called once per statistics window, so a dead bus costs at most
+ *         one re-initialization attempt per second; between attempts the
+ *         driver drops its writes (offline) instead of halting the clock.
+ *         ssd1306_Recover() only acts after a failed write: a glitch may
+ *         have reset the panel, so it re-sends the init string and blanks
+ *         the screen. The panel then runs at full contrast and on, so the
+ *         tracked state is put back (contrast, or the deep sleep) and the
+ *         current screen is redrawn. The setting screens are entered again
+ *         from the stored values (an edit in progress restarts), the sync
+ *         and error screens get their title back (the message row returns
+ *         with the next event). The redraw runs on the 64 MHz clock.
+ *
+ * @param  ctx  Display context — reads isOn, contrast, reads/writes state, lastClockUpdate
+ * @param  buf  Caller-provided 11-byte scratch buffer
+ */
+static void displayRecover(displayCtx_t *ctx, char *buf) {
+	if (!ssd1306_Recover()) {
+		return;
+	}
+	sysClockBoost(SYSCLK_USER_DISPLAY);
+	if (ctx->isOn) {
+		ssd1306_SetContrast(ctx->contrast);
+	} else {
+		ssd1306_Sleep();
+	}
+
+	switch (ctx->state) {
+	case DISP_SET_RTC:        enterSetRtc(ctx, buf);  break;
+	case DISP_SET_SILENT:     enterSetSilent(ctx, buf);  break;
+	case DISP_SET_CORRECTION: enterSetCorrection(ctx, buf);  break;
+	case DISP_SET_WEEK:       enterSetWeek(ctx, buf);  break;
+	case DISP_DIAG:
+		displayTitle(ctx->state, buf);
+		diagShowPage(ctx, buf, 1);
+		break;
+	case DISP_SYNC:
+	case DISP_ERROR:
+		displayTitle(ctx->state, buf);
+		break;
+	default:
+		ctx->lastClockUpdate = xTaskGetTickCount() - pdMS_TO_TICKS(DISPLAY_CLOCK_INTERVAL) - 10;
+		break;
+	}
+}
+
+
 /**
  * @brief  FreeRTOS task: OLED display controller and UI state machine.
  *
@@ -627,13 +1189,25 @@ static void handleSetCorrBtns(uint32_t eventId, displayCtx_t *ctx, char *buf) {
  *         - DISP_SET_CORRECTION: Digit-by-digit calibration editing (±NNN)
  *         - DISP_SYNC:           Mechanical sync in progress (buttons disabled)
  *         - DISP_ERROR:          Error message displayed
+ *         - DISP_DIAG:           Hidden diagnostic counters (INC+DEC chord)
+ *         - DISP_SET_WEEK:       Weekly silent schedule, hour by hour
  *
  *         Event handling:
  *         - DISP_EV_FORCE_SETUP (999): First-boot wizard chain
- *         - Button events (101-106): Dispatched to per-state handlers
+ *         - Button events (101-107): Dispatched to per-state handlers
  *         - Sync events (201-206): Show sync progress messages
  *         - Error events (301-309): Show error messages
- *         - Timeout (no event): Refresh clock display + auto-off check
+ *         - Timeout (no event): Refresh clock display + auto-off check,
+ *           close the run time statistics window every second (and refresh
+ *           the diagnostic page with it), recover from display bus faults
+ *           (displayRecover())
+ *
+ *         The worst case duration of a button handler or clock refresh is
+ *         tracked in sysStats.renderTimeMax (statsRenderTime()), and its
+ *         bus traffic is checked against the DISPLAY_BUDGET_xxx bounds
+ *         (displayBudgetCheck()).
+ *         Events and renders run on the 64 MHz clock (sysClockBoost); the
+ *         clock is released at the top of the loop, before the next wait.
  *
  *         Display wake logic: if display is OFF and any button is pressed,
  *         the display turns ON but the event is NOT forwarded to handlers
@@ -661,23 +1235,28 @@ void displayTask(void *parameters) {
 		.state = DISP_SYNC,
 		.digitCursor = 0,
 		.isOn = OFF,
+		.contrast = DISPLAY_CONTRAST_DAY,
 		.lastOnTime = xTaskGetTickCount(),
 		.lastClockUpdate = xTaskGetTickCount(),
+		.lastStatsUpdate = xTaskGetTickCount(),
 	};
 
 	while (1) {
+		sysClockRelease(SYSCLK_USER_DISPLAY);  // Rendering done: back to the idle clock
 		if (xTaskNotifyWait(0, 0xffffffff, &eventId, pdMS_TO_TICKS(DISPLAY_TASK_DELAY)) == pdTRUE) {
+			sysClockBoost(SYSCLK_USER_DISPLAY);
 
 			// First boot → full setup: silent hours → calibration → time
 			if (eventId == DISP_EV_FORCE_SETUP) {
 				ctx.setupMode = 1;
 				enterSetSilent(&ctx, buf);
+				displayBandFlush();
 				displayOnOff(ON, &ctx);
 				vTaskResume(buttonTaskHandle);
 				continue;
 			}
 
-			// *** BUTTON EVENTS (101-106) ***
+			// *** BUTTON EVENTS (101-107) ***
 			if ((eventId > 100) && (eventId < 200)) {
 				uint8_t wasOff = !ctx.isOn;
 				displayOnOff(ON, &ctx);
@@ -687,14 +1266,22 @@ void displayTask(void *parameters) {
 					continue;  // Wake only, don't process
 				}
 
+				uint32_t renderStart = statsGetCounter();
+				ssd1306Stats_t busStart = *ssd1306_GetStats();
+				uint8_t prevState = ctx.state;
 				switch (ctx.state) {
 				case DISP_CLOCK:          handleClockBtns(eventId, &ctx, buf);  break;
-				case DISP_SET_RTC:        handleSetRtcBtns(eventId, &ctx);      break;
+				case DISP_SET_RTC:        handleSetRtcBtns(eventId, &ctx, buf);  break;
 				case DISP_SET_SILENT:     handleSetSilentBtns(eventId, &ctx, buf);  break;
 				case DISP_SET_CORRECTION: handleSetCorrBtns(eventId, &ctx, buf);  break;
+				case DISP_DIAG:           handleDiagBtns(eventId, &ctx, buf);  break;
+				case DISP_SET_WEEK:       handleSetWeekBtns(eventId, &ctx, buf);  break;
 				case DISP_ERROR:          break;
 				case DISP_SYNC:           break;
 				}
+				displayBandFlush();
+				statsRenderTime(renderStart);
+				displayBudgetCheck((ctx.state != prevState) ? DISP_BUDGET_ENTER : DISP_BUDGET_EDIT, &busStart);
 
 				if (ctx.state != DISP_SYNC) {
 					vTaskResume(buttonTaskHandle);
@@ -703,20 +1290,26 @@ void displayTask(void *parameters) {
 
 			// *** SYNC EVENTS (201-206) ***
 			if ((eventId > 200) && (eventId < 300)) {
+				ssd1306Stats_t busStart = *ssd1306_GetStats();
 				ctx.state = DISP_SYNC;
 				displayOnOff(ON, &ctx);
 
 				if (eventId == DISP_EV_SYN_START) {
 					ssd1306_ClearScreen();
 					displayTitle(ctx.state, buf);
+					displayBudgetCheck(DISP_BUDGET_ENTER, &busStart);
+					busStart = *ssd1306_GetStats();
 				}
 
 				displayMessage(eventId - DISP_EV_SYN_START, buf);
+				displayBudgetCheck(DISP_BUDGET_MSG, &busStart);
 
 				if (eventId == DISP_EV_SYN_END) {
 					ctx.state = DISP_CLOCK;
 					vTaskDelay(pdMS_TO_TICKS(1000));
+					busStart = *ssd1306_GetStats();
 					ssd1306_ClearScreen();
+					displayBudgetCheck(DISP_BUDGET_CLEAR, &busStart);
 					displayOnOff(ON, &ctx);
 					ctx.lastClockUpdate = xTaskGetTickCount() - pdMS_TO_TICKS(DISPLAY_CLOCK_INTERVAL) - 10;
 					vTaskResume(buttonTaskHandle);
@@ -728,18 +1321,43 @@ void displayTask(void *parameters) {
 				ctx.state = DISP_ERROR;
 				displayOnOff(ON, &ctx);
 				displayTitle(ctx.state, buf);
+				ssd1306Stats_t busStart = *ssd1306_GetStats();
 				displayMessage(eventId - DISP_EV_ERR_START, buf);
+				displayBudgetCheck(DISP_BUDGET_MSG, &busStart);
 				vTaskResume(buttonTaskHandle);
 			}
 
 		} else {  // Event wait timed out
 
+			// Close the run time statistics window
+			if (timeLapsed(xTaskGetTickCount(), ctx.lastStatsUpdate) >= pdMS_TO_TICKS(STATS_UPDATE_INTERVAL)) {
+				uint32_t upTime = sysStats.uptime;
+				statsUpdate();
+				ctx.lastStatsUpdate = xTaskGetTickCount();
+				if (ctx.isOn) {  // OLED current model inputs
+					sysStats.oledOnTime += sysStats.uptime - upTime;
+					sysStats.oledContrastTime += (sysStats.uptime - upTime) * ctx.contrast;
+				}
+				displayRecover(&ctx, buf);
+				if (ctx.state == DISP_DIAG) {
+					sysClockBoost(SYSCLK_USER_DISPLAY);
+					diagShowPage(&ctx, buf, 0);
+				}
+			}
+
 			// Time clock display
 			if (ctx.state == DISP_CLOCK) {
 				if (timeLapsed(xTaskGetTickCount(), ctx.lastClockUpdate) > pdMS_TO_TICKS(DISPLAY_CLOCK_INTERVAL)) {
+					sysClockBoost(SYSCLK_USER_DISPLAY);
+					uint32_t renderStart = statsGetCounter();
+					ssd1306Stats_t busStart = *ssd1306_GetStats();
+					displayUpdateContrast(&ctx);
 					displayTitle(DISP_CLOCK, buf);
 					displayUpdateTimeVar(ctx.showTime);
 					displayShowClock(ctx.showTime);
+					displayBandFlush();
+					statsRenderTime(renderStart);
+					displayBudgetCheck(DISP_BUDGET_CLOCK, &busStart);
 					ctx.lastClockUpdate = xTaskGetTickCount();
 				}
 			}
@@ -748,6 +1366,9 @@ void displayTask(void *parameters) {
 			if (ctx.state != DISP_SYNC) {
 				if (timeLapsed(xTaskGetTickCount(), ctx.lastOnTime) > pdMS_TO_TICKS(DISPLAY_OFF_TIMEOUT)) {
 					displayOnOff(OFF, &ctx);
+					if ((ctx.state != DISP_CLOCK) && (ctx.state != DISP_ERROR)) {
+						ssd1306_ClearScreen();  // Diagnostic, week and cursor rows are not covered by the clock digits
+					}
 					if (ctx.state != DISP_ERROR) {
 						ctx.state = DISP_CLOCK;
 					}
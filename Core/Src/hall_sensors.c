@@ -0,0 +1,116 @@
+/**
+ * @file   hall_sensors.c
+ * @brief  Hall sensor (SNS_HOUR, SNS_DAY) edge capture with microsecond
+ *         timestamps.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include "rtos_init.h"
+#include "hall_sensors.h"
+#include "sys_stats.h"
+
+
+// Edge ring buffer, written by the EXTI interrupt only
+static hallEdge_t hallEdges[HALL_EDGE_BUF_SIZE];
+static volatile uint32_t hallEdgeCount;		// Edges captured since boot (write index)
+
+
+/**
+ * @brief  Route SNS_HOUR (PA8) and SNS_DAY (PA9) to EXTI on both edges.
+ *
+ *         Called from MX_GPIO_Init() (USER CODE section) after the pins have
+ *         been configured as plain inputs with pull-up. Lines 8 and 9 share
+ *         the EXTI4_15 interrupt; its handler is in stm32g0xx_it.c.
+ *
+ *         HAL_GPIO_Init with GPIO_MODE_IT_RISING_FALLING: selects port A on
+ *         the EXTI line mux and enables both trigger edges. The pin still
+ *         reads through HAL_GPIO_ReadPin as before.
+ *
+ */
+void hallInitEdges(void) {
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	GPIO_InitStruct.Pin = SNS_HOUR_Pin | SNS_DAY_Pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
+	GPIO_InitStruct.Pull = GPIO_PULLUP;
+	HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+	HAL_NVIC_SetPriority(EXTI4_15_IRQn, HALL_EXTI_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(EXTI4_15_IRQn);
+}
+
+
+/**
+ * @brief  Store a sensor edge in the ring buffer (interrupt context).
+ *
+ *         Called from HAL_GPIO_EXTI_Rising/Falling_Callback (main.c). The
+ *         timestamp is the run time statistics counter (TIM2, 1 us), so an
+ *         edge can be placed precisely inside a 200 ms coil pulse. Every
+ *         bounce is captured: a short magnet pass that is over before the
+ *         task samples the pin is no longer lost.
+ *
+ *         Single producer: no lock, the count is published after the entry.
+ *
+ * @param  GPIO_Pin  EXTI pin (SNS_HOUR_Pin or SNS_DAY_Pin)
+ * @param  level     Pin level after the edge (1 = rising, 0 = falling)
+ */
+void hallEdgeCallback(uint16_t GPIO_Pin, uint8_t level) {
+	hallEdge_t *edge = &hallEdges[hallEdgeCount & HALL_EDGE_BUF_MASK];
+
+	edge->time = statsGetCounter();
+	edge->sensor = (GPIO_Pin == SNS_DAY_Pin) ? HALL_DAY : HALL_HOUR;
+	edge->level = level;
+	hallEdgeCount++;
+}
+
+
+/**
+ * @brief  Mark the current position in the edge stream.
+ *
+ *         Take a mark before a coil pulse or servo stroke, then query the
+ *         edges that happened after it with hallEdgeFirst().
+ *
+ * @return Opaque mark (edges captured so far)
+ */
+uint32_t hallEdgeMark(void) {
+	return hallEdgeCount;
+}
+
+
+/**
+ * @brief  Get the first edge of a sensor captured after a mark.
+ *
+ *         The direction of the FIRST edge tells the transition the magnet
+ *         made, bounces included: a bouncing 1→0 transition starts with a
+ *         falling edge, a short 0→1→0 pass starts with a rising one.
+ *
+ *         Scans at most HALL_EDGE_BUF_SIZE entries: when more edges than that
+ *         happened since the mark, only the most recent ones are examined.
+ *
+ * @param  mark      Value returned by hallEdgeMark()
+ * @param  sensor    Sensor to look for (hallSensorEnum)
+ * @param[out] edge  Copy of the edge, written only when found
+ * @return 1 if the sensor had an edge after the mark, 0 otherwise
+ */
+uint8_t hallEdgeFirst(uint32_t mark, uint8_t sensor, hallEdge_t *edge) {
+	uint32_t count = hallEdgeCount;
+
+	if ((count - mark) > HALL_EDGE_BUF_SIZE) {
+		mark = count - HALL_EDGE_BUF_SIZE;
+	}
+
+	for (; mark != count; mark++) {
+		if (hallEdges[mark & HALL_EDGE_BUF_MASK].sensor == sensor) {
+			*edge = hallEdges[mark & HALL_EDGE_BUF_MASK];
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -23,6 +23,10 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "rtos_init.h"
+#include "clock_task.h"
+#include "hall_sensors.h"
+#include "time_service.h"
+#include "power_mgr.h"
 #include "ssd1306.h"
 /* USER CODE END Includes */
 
@@ -411,20 +415,48 @@ static void MX_GPIO_Init(void)
   HAL_NVIC_EnableIRQ(EXTI0_1_IRQn);
 
   /* USER CODE BEGIN MX_GPIO_Init_2 */
+  hallInitEdges();	// SNS_HOUR/SNS_DAY edges on EXTI4_15
+  coilInitPwm();	// CLK_TICK/CLK_TOCK driven by TIM3 CH1/CH2
   /* USER CODE END MX_GPIO_Init_2 */
 }
 
 /* USER CODE BEGIN 4 */
 /* Callback to enter in shutdown mode after a power loss
- *
+ * (the clock actuation is stopped and its journal settled first)
  */
 void HAL_GPIO_EXTI_Falling_Callback(uint16_t GPIO_Pin){
 	if (GPIO_Pin == GPIO_PIN_1) {
+		clockPowerFail();
 		__HAL_PWR_CLEAR_FLAG(PWR_FLAG_WUF);
 		HAL_PWR_EnableWakeUpPin(PWR_WAKEUP_PIN1_HIGH);
 		HAL_PWREx_EnterSHUTDOWNMode(); // Shutdown the MCU
+	} else if (GPIO_Pin & POWER_WAKE_PINS) {
+		powerButtonCallback();  // Button wake from STOP (silent period)
+	} else {
+		hallEdgeCallback(GPIO_Pin, 0);
 	}
 }
+
+/* Hall sensor edges (SNS_HOUR, SNS_DAY)
+ *
+ */
+void HAL_GPIO_EXTI_Rising_Callback(uint16_t GPIO_Pin){
+	hallEdgeCallback(GPIO_Pin, 1);
+}
+
+/* RTC alarm A: publish the time snapshot once per second
+ *
+ */
+void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc){
+	timeServiceAlarmCallback();
+}
+
+/* RTC alarm B: end of the silent period, wake from STOP
+ *
+ */
+void HAL_RTCEx_AlarmBEventCallback(RTC_HandleTypeDef *hrtc){
+	powerAlarmCallback();
+}
 /* USER CODE END 4 */
 
 /**
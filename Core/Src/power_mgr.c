@@ -0,0 +1,293 @@
+/**
+ * @file   power_mgr.c
+ * @brief  Silent period power mode: STOP with the end-of-silence alarm and
+ *         the buttons as the only wake sources.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include "rtos_init.h"
+#include "rtc_helpers.h"
+#include "power_mgr.h"
+#include "sys_stats.h"
+#include "sys_clock.h"
+
+
+// Wake source, written by the alarm B and button EXTI interrupts
+static volatile uint8_t powerWake;
+
+// Display state as last reported by displayTask
+static volatile uint8_t powerDisplayOn;
+
+// Button wake hold-off (no new sleep until buttonTask had time to report the press)
+static uint8_t powerWakeHold;
+static TickType_t powerWakeTick;
+
+
+/**
+ * @brief  Find the end of the current silent period.
+ *
+ *         Walks the weekly schedule forward from the hour after the current
+ *         one: silence ends at :00 of the first hour that is not silent.
+ *
+ * @param  now       Current time snapshot
+ * @param[out] day   Weekday of the end (RTC_WEEKDAY_MONDAY..SUNDAY)
+ * @param[out] hour  Hour of the end (0-23)
+ * @return 1 = found, 0 = the whole week is silent or the weekday is not valid
+ */
+static uint8_t powerSilentEnd(const timeSnapshot_t *now, uint8_t *day, uint8_t *hour) {
+	uint8_t d = now->weekDay;
+	uint8_t h = now->hours;
+
+	if ((d < RTC_WEEKDAY_MONDAY) || (d > RTC_WEEKDAY_SUNDAY)) {
+		return 0;
+	}
+
+	for (uint8_t n = 0; n < (SILENT_DAYS * 24); n++) {
+		if (++h == 24) {
+			h = 0;
+			d = (d == RTC_WEEKDAY_SUNDAY) ? RTC_WEEKDAY_MONDAY : (d + 1);
+		}
+		if (!(getSilentDayMap(d) & (1UL << h))) {
+			*day = d;
+			*hour = h;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+/**
+ * @brief  Program RTC alarm B at the end of the silent period.
+ *
+ *         Weekday, hours, minutes and seconds all have to match, so the
+ *         alarm fires once, up to a week ahead. The alarm shares the RTC_TAMP
+ *         interrupt with alarm A (time service).
+ *
+ *         HAL_RTC_SetAlarm_IT(): programs the alarm and enables its EXTI
+ *         line, which is what wakes the MCU from STOP.
+ *
+ * @param  day   Weekday of the end (RTC_WEEKDAY_MONDAY..SUNDAY)
+ * @param  hour  Hour of the end (0-23)
+ * @return 1 = alarm armed
+ */
+static uint8_t powerSetEndAlarm(uint8_t day, uint8_t hour) {
+	RTC_AlarmTypeDef alarm = {0};
+	uint8_t tens = (uint8_t) divu10(hour);
+
+	alarm.Alarm = RTC_ALARM_B;
+	alarm.AlarmTime.Hours = (uint8_t)((tens << 4) | (hour - (tens * 10)));
+	alarm.AlarmMask = RTC_ALARMMASK_NONE;
+	alarm.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_ALL;
+	alarm.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_WEEKDAY;
+	alarm.AlarmDateWeekDay = day;
+	return (HAL_RTC_SetAlarm_IT(hrtcHandle, &alarm, RTC_FORMAT_BCD) == HAL_OK);
+}
+
+
+/**
+ * @brief  Route the buttons (PB3, PB4, PB5) to EXTI, falling edge.
+ *
+ *         The pins stay inputs with pull-up; only the EXTI line mux and the
+ *         trigger are added. PB3 is on EXTI2_3, PB4/PB5 share EXTI4_15 with
+ *         the hall sensors; both handlers are in stm32g0xx_it.c.
+ *         A button already held down has no edge left to wake on, so it is
+ *         reported as a wake right away.
+ *
+ */
+static void powerArmButtons(void) {
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	GPIO_InitStruct.Pin = POWER_WAKE_PINS;
+	GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
+	GPIO_InitStruct.Pull = GPIO_PULLUP;
+	HAL_GPIO_Init(BTN_SET_GPIO_Port, &GPIO_InitStruct);
+	__HAL_GPIO_EXTI_CLEAR_FALLING_IT(POWER_WAKE_PINS);
+
+	HAL_NVIC_SetPriority(EXTI2_3_IRQn, POWER_WAKE_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(EXTI2_3_IRQn);
+
+	if ((BTN_SET_GPIO_Port->IDR & POWER_WAKE_PINS) != POWER_WAKE_PINS) {
+		powerWake = POWER_WAKE_BUTTON;
+	}
+}
+
+
+/**
+ * @brief  Take the buttons off EXTI (buttonTask polls them while awake).
+ *
+ */
+static void powerDisarmButtons(void) {
+	HAL_NVIC_DisableIRQ(EXTI2_3_IRQn);
+	EXTI->IMR1 &= ~POWER_WAKE_PINS;
+	EXTI->FTSR1 &= ~POWER_WAKE_PINS;
+	__HAL_GPIO_EXTI_CLEAR_FALLING_IT(POWER_WAKE_PINS);
+}
+
+
+/**
+ * @brief  Position inside the week in seconds (Monday 00:00:00 = 0).
+ *
+ * @param  snap  Time snapshot
+ * @return Seconds since Monday midnight
+ */
+static uint32_t powerWeekSeconds(const timeSnapshot_t *snap) {
+	uint32_t day = (snap->weekDay > RTC_WEEKDAY_MONDAY) ? (snap->weekDay - RTC_WEEKDAY_MONDAY) : 0;
+
+	return (((day * 24 + snap->hours) * 60 + snap->minutes) * 60) + snap->seconds;
+}
+
+
+/**
+ * @brief  Spend the rest of the silent period in STOP mode.
+ *
+ *         Called by clockTask on every poll inside the silent period. Returns
+ *         at once (POWER_WAKE_NONE) while the display is on, during the
+ *         hold-off after a button wake, or when the schedule has no end.
+ *
+ *         Otherwise every wake source but two is disarmed: RTC alarm B at
+ *         the end of the silent period and the three buttons. Alarm A (the
+ *         1 Hz time service) is stopped and the hall sensor lines are
+ *         masked; PW_MON stays armed, a power loss still shuts down from STOP.
+ *         The tasks are parked by suspending the scheduler, and both tick
+ *         sources are stopped so they do not wake the core.
+ *
+ *         HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, WFI): STOP 1, all
+ *         the clocks but LSE/LSI are off and the RAM is retained. The core
+ *         resumes after the WFI on HSI16, so sysClockResume() restores the
+ *         clock level (and the timers) before anything else runs.
+ *
+ *         vTaskSuspendAll() / xTaskResumeAll(): no context switch happens
+ *         in between, the interrupts stay enabled. The tick counter does
+ *         not advance while the MCU is in STOP, so uptime counts awake time
+ *         and the sleep time is measured on the RTC instead.
+ *
+ * @param  now  Current time snapshot (inside the silent period)
+ * @return Wake source (powerWakeEnum)
+ */
+uint8_t powerSilentSleep(const timeSnapshot_t *now) {
+	uint8_t endDay, endHour;
+	uint32_t hallMask, slept;
+	timeSnapshot_t after;
+
+	if (powerDisplayOn) {
+		return POWER_WAKE_NONE;
+	}
+	if (powerWakeHold) {
+		if (timeLapsed(xTaskGetTickCount(), powerWakeTick) < pdMS_TO_TICKS(POWER_WAKE_HOLDOFF)) {
+			return POWER_WAKE_NONE;
+		}
+		powerWakeHold = 0;
+	}
+
+	powerWake = POWER_WAKE_NONE;
+	if (!powerSilentEnd(now, &endDay, &endHour) || !powerSetEndAlarm(endDay, endHour)) {
+		return POWER_WAKE_NONE;
+	}
+
+	vTaskSuspendAll();
+	timeServiceSuspend();
+	hallMask = EXTI->IMR1 & (SNS_HOUR_Pin | SNS_DAY_Pin);
+	EXTI->IMR1 &= ~hallMask;
+	powerArmButtons();
+	HAL_SuspendTick();
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+	while (powerWake == POWER_WAKE_NONE) {
+		HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+		sysStats.wakeups++;
+	}
+
+	HAL_ResumeTick();
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	sysClockResume();		// STOP exits on HSI16: back to the current clock level
+	powerDisarmButtons();
+	EXTI->RPR1 = hallMask;	// Drop edges seen while masked
+	EXTI->FPR1 = hallMask;
+	EXTI->IMR1 |= hallMask;
+	HAL_RTC_DeactivateAlarm(hrtcHandle, RTC_ALARM_B);
+	timeServiceResume();
+	xTaskResumeAll();
+
+	timeGetSnapshot(&after);
+	slept = powerWeekSeconds(&after) + POWER_WEEK_SECONDS - powerWeekSeconds(now);
+	if (slept >= POWER_WEEK_SECONDS) {
+		slept -= POWER_WEEK_SECONDS;
+	}
+	sysStats.sleepTime += slept;
+	sysStats.currentEstimate = powerCurrentEstimate();
+
+	if (powerWake == POWER_WAKE_BUTTON) {
+		powerWakeHold = 1;
+		powerWakeTick = xTaskGetTickCount();
+	}
+	return powerWake;
+}
+
+
+/**
+ * @brief  RTC alarm B callback: the silent period is over (interrupt context).
+ *
+ *         Called from HAL_RTCEx_AlarmBEventCallback (main.c).
+ *
+ */
+void powerAlarmCallback(void) {
+	powerWake = POWER_WAKE_ALARM;
+}
+
+
+/**
+ * @brief  Button EXTI callback (interrupt context).
+ *
+ *         Called from HAL_GPIO_EXTI_Falling_Callback (main.c). Only wakes
+ *         the MCU: the press itself is debounced and reported by buttonTask,
+ *         which turns the display on.
+ *
+ */
+void powerButtonCallback(void) {
+	powerWake = POWER_WAKE_BUTTON;
+}
+
+
+/**
+ * @brief  Record the display state (no STOP while the display is on).
+ *
+ *         Called by displayTask whenever it switches the display on or off.
+ *
+ * @param  on  ON (1) or OFF (0)
+ */
+void powerSetDisplayOn(uint8_t on) {
+	powerDisplayOn = on;
+}
+
+
+/**
+ * @brief  Estimate the average MCU current since boot.
+ *
+ *         Weighs POWER_RUN_CURRENT by the awake time (uptime, the tick does
+ *         not count STOP) and POWER_STOP_CURRENT by the sleep time measured
+ *         on the RTC. The awake share is taken in per mille, so only 32-bit
+ *         divisions are needed.
+ *
+ * @return Estimated average current in uA
+ */
+uint32_t powerCurrentEstimate(void) {
+	uint32_t scale = (sysStats.uptime + sysStats.sleepTime) / 1000;
+	uint32_t awake;
+
+	if (scale == 0) {
+		return POWER_RUN_CURRENT;
+	}
+	awake = sysStats.uptime / scale;
+	if (awake > 1000) {
+		awake = 1000;
+	}
+	return POWER_STOP_CURRENT + (((POWER_RUN_CURRENT - POWER_STOP_CURRENT) * awake) / 1000);
+}
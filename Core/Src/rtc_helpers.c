@@ -1,6 +1,6 @@
 /**
  * @file   rtc_helpers.c
- * @brief  RTC backup register utilities, Flash settings storage,
+ * @brief  RTC backup register utilities, Flash settings and event log,
  *         calibration, and silent period helpers.
  *
  * @version 2.0
@@ -14,11 +14,26 @@
 
 #include "rtos_init.h"
 #include "rtc_helpers.h"
+#include "time_service.h"
+#include "timers.h"
 
 
-// Struct to set and read the real time clock
-RTC_TimeTypeDef RTC_Time;
-RTC_DateTypeDef RTC_Date;
+// RAM copy of the mechanism state word in DR0 (loaded by getMechState on first use)
+static uint32_t mechState;
+static uint8_t mechStateLoaded;
+
+// Weekly silent schedule: hour map per weekday (Monday first) and its lookup form
+static uint32_t silentMap[SILENT_DAYS];
+static uint32_t silentLookup[SILENT_DAYS];
+static uint8_t silentDirty;				// Days waiting for the Flash write (bit 0 = all days)
+
+// Flash log state (found by flashLogScan on first use)
+static uint8_t flashLogPage = FLASH_PAGE_NONE;	// Active slot (0 = page 30, 1 = page 31)
+static uint32_t flashLogSeq;			// Sequence number of the active slot
+static int16_t flashLogNext = -1;		// Next free record (-1 = not scanned yet)
+static uint8_t flashSettingsValid;		// A settings record exists
+static uint32_t flashSettingsLast;		// Payload of the latest settings record
+static TimerHandle_t flashSettingsTimer;	// One-shot deferred settings write
 
 
 /*
@@ -28,40 +43,159 @@ RTC_DateTypeDef RTC_Date;
  */
 
 /**
- * @brief  Read mechanical clock hours from RTC backup register DR0.
+ * @brief  Return the mechanism state word, loading the RAM copy on first use.
+ *
+ *         The whole mechanism state (position, tick polarity, journal flags,
+ *         power-fail record and a sequence tag) lives in backup register DR0.
+ *         The RAM copy is the only thing read afterwards: the backup domain
+ *         sits behind the APB bridge and each HAL access costs a call.
+ *
+ * @return Packed state word (RTC_BKP_MECH_* / RTC_BKP_FLAG_* fields)
+ */
+static uint32_t getMechState(void) {
+	if (!mechStateLoaded) {
+		mechState = HAL_RTCEx_BKUPRead(hrtcHandle, RTC_BKP_MECH_STATE);
+		mechStateLoaded = 1;
+	}
+	return mechState;
+}
+
+/**
+ * @brief  Store a new mechanism state word with a single register write.
+ *
+ *         The sequence tag in bits 31:24 is bumped on every write, so a
+ *         debugger (or a later boot) can tell two otherwise equal states
+ *         apart. A 32-bit backup register write cannot be torn by a reset:
+ *         after a power loss DR0 holds either the old or the new state.
+ *
+ * @param  state  New state word (the sequence field is ignored)
+ */
+static void setMechState(uint32_t state) {
+	uint32_t seq = (getMechState() + (1UL << RTC_BKP_MECH_SEQ_SHIFT)) & RTC_BKP_MECH_SEQ_MASK;
+	mechState = (state & ~RTC_BKP_MECH_SEQ_MASK) | seq;
+	HAL_RTCEx_BKUPWrite(hrtcHandle, RTC_BKP_MECH_STATE, mechState);
+}
+
+/**
+ * @brief  Build a state word with a new position, keeping the other fields.
+ *
+ * @param  state    Current state word
+ * @param  hours    Hour value to store (0-23)
+ * @param  minutes  Minute value to store (0-59)
+ * @return State word with the position fields replaced
+ */
+static uint32_t mechStateWithPosition(uint32_t state, uint8_t hours, uint8_t minutes) {
+	state &= ~(RTC_BKP_MECH_HOURS_MASK | RTC_BKP_MECH_MINUTES_MASK);
+	return state | ((uint32_t)hours << RTC_BKP_MECH_HOURS_SHIFT) | (uint32_t)minutes;
+}
+
+/**
+ * @brief  Read mechanical clock hours from the cached state word.
  *
- *         The mechanical clock position is tracked in backup registers so it
- *         survives power cycles. Returns 0 if the stored value is out of
+ *         The mechanical clock position is tracked in a backup register so
+ *         it survives power cycles. Returns 0 if the stored value is out of
  *         range (> 23), which happens on first battery insertion.
  *
  * @return Mechanical hours (0-23)
  */
 uint8_t getMechHours(void) {
-	uint8_t hours = (uint8_t)(HAL_RTCEx_BKUPRead(hrtcHandle, RTC_BKP_MECH_HOURS) & 0xFF);
+	uint8_t hours = (uint8_t)((getMechState() & RTC_BKP_MECH_HOURS_MASK) >> RTC_BKP_MECH_HOURS_SHIFT);
 	return (hours > 23) ? 0 : hours;
 }
 
 /**
- * @brief  Read mechanical clock minutes from RTC backup register DR1.
+ * @brief  Read mechanical clock minutes from the cached state word.
  *
  *         Returns 0 if the stored value is out of range (> 59).
  *
  * @return Mechanical minutes (0-59)
  */
 uint8_t getMechMinutes(void) {
-	uint8_t minutes = (uint8_t)(HAL_RTCEx_BKUPRead(hrtcHandle, RTC_BKP_MECH_MINUTES) & 0xFF);
+	uint8_t minutes = (uint8_t)(getMechState() & RTC_BKP_MECH_MINUTES_MASK);
 	return (minutes > 59) ? 0 : minutes;
 }
 
 /**
- * @brief  Write mechanical clock position to backup registers DR0 and DR1.
+ * @brief  Set or clear flag bits in the mechanism state word.
+ *
+ * @param  mask  Flag bits (RTC_BKP_FLAG_*)
+ * @param  set   1 = set the bits, 0 = clear them
+ */
+static void setBkpFlags(uint32_t mask, uint8_t set) {
+	uint32_t state = getMechState();
+
+	if (set) {
+		state |= mask;
+	} else {
+		state &= ~mask;
+	}
+
+	setMechState(state);
+}
+
+/**
+ * @brief  Check whether the stored position can be trusted.
+ *
+ *         The position journal has two bits: POS_VALID is set once the
+ *         sensors referenced the mechanism (markMechZero) and cleared by
+ *         resetMechPosition(); STEP_BUSY is set before each coil pulse or
+ *         servo stroke (beginMechStep) and cleared when the step is committed
+ *         by incrementMechMinute/Hour. A step left in flight by a power loss
+ *         may or may not have moved the flap, so the position is unknown.
+ *
+ * @return 1 if the position is valid and no step was interrupted
+ */
+uint8_t isMechPositionValid(void) {
+	uint32_t state = getMechState();
+	return ((state & (RTC_BKP_FLAG_POS_VALID | RTC_BKP_FLAG_STEP_BUSY)) == RTC_BKP_FLAG_POS_VALID) ? 1 : 0;
+}
+
+/**
+ * @brief  Journal the start of a coil pulse or servo stroke.
+ *
+ *         Called just before energizing the coil or engaging the servo.
+ *         The matching commit is incrementMechMinute()/incrementMechHour().
  *
- * @param  hours    Hour value to store (0-23)
- * @param  minutes  Minute value to store (0-59)
  */
-static void setMechPosition(uint8_t hours, uint8_t minutes) {
-	HAL_RTCEx_BKUPWrite(hrtcHandle, RTC_BKP_MECH_HOURS, (uint32_t)hours);
-	HAL_RTCEx_BKUPWrite(hrtcHandle, RTC_BKP_MECH_MINUTES, (uint32_t)minutes);
+void beginMechStep(void) {
+	setBkpFlags(RTC_BKP_FLAG_STEP_BUSY, 1);
+}
+
+/**
+ * @brief  Abort the journaled step, leaving the position unchanged.
+ *
+ *         Called by the power-fail handler when the pulse was cut short
+ *         before it could move the flap.
+ *
+ */
+void rollbackMechStep(void) {
+	setBkpFlags(RTC_BKP_FLAG_STEP_BUSY, 0);
+}
+
+/**
+ * @brief  Store the power-fail handler outcome in the mechanism state word.
+ *
+ *         Written from the PW_MON interrupt within the hold-up time: the
+ *         Flash is far too slow for that, so the event is parked in the
+ *         backup domain and moved to the Flash log at the next boot.
+ *
+ * @param  outcome  Handler outcome (powerFailEnum)
+ */
+void setPowerFailRecord(uint8_t outcome) {
+	uint32_t state = getMechState();
+	state = (state & ~RTC_BKP_FLAG_PF_MASK) | (((uint32_t)outcome << RTC_BKP_FLAG_PF_SHIFT) & RTC_BKP_FLAG_PF_MASK);
+	setMechState(state);
+}
+
+/**
+ * @brief  Read and clear the power-fail record of the previous run.
+ *
+ * @return Handler outcome (powerFailEnum), PF_NOT_DETECTED if none
+ */
+uint8_t takePowerFailRecord(void) {
+	uint32_t state = getMechState();
+	setBkpFlags(RTC_BKP_FLAG_PF_MASK, 0);
+	return (uint8_t)((state & RTC_BKP_FLAG_PF_MASK) >> RTC_BKP_FLAG_PF_SHIFT);
 }
 
 /**
@@ -69,11 +203,14 @@ static void setMechPosition(uint8_t hours, uint8_t minutes) {
  *
  *         Called after each coil pulse advances the minute flap.
  *         Handles 59→00 minute rollover and 23→00 hour rollover.
+ *         In the same write the tick/tock polarity is flipped and the step
+ *         journaled by beginMechStep() is committed.
  *
  */
 void incrementMechMinute(void) {
 	uint8_t hours = getMechHours();
 	uint8_t minutes = getMechMinutes();
+	uint32_t state = getMechState();
 
 	minutes++;
 	if (minutes >= 60) {
@@ -83,7 +220,9 @@ void incrementMechMinute(void) {
 			hours = 0;
 		}
 	}
-	setMechPosition(hours, minutes);
+	state = mechStateWithPosition(state, hours, minutes);
+	state ^= RTC_BKP_FLAG_LAST_TICK;
+	setMechState(state & ~RTC_BKP_FLAG_STEP_BUSY);
 }
 
 /**
@@ -92,6 +231,7 @@ void incrementMechMinute(void) {
  *         Called after each servo actuation advances the hour flap.
  *         Handles 23→00 rollover. Minutes are set to 0 because the
  *         servo always advances from an hour boundary (XX:00).
+ *         Commits the step journaled by beginMechStep().
  *
  */
 void incrementMechHour(void) {
@@ -100,51 +240,59 @@ void incrementMechHour(void) {
 	if (hours >= 24) {
 		hours = 0;
 	}
-	setMechPosition(hours, 0);
+	setMechState(mechStateWithPosition(getMechState(), hours, 0) & ~RTC_BKP_FLAG_STEP_BUSY);
 }
 
 /**
- * @brief  Reset mechanical position to 00:00 in backup registers.
+ * @brief  Forget the mechanical position (00:00, not valid).
  *
- *         Called at startup to force a sensor-based search, and when
- *         mechanical drift is detected during normal operation.
+ *         Called at startup when the journal cannot be trusted (battery
+ *         lost or step interrupted), and when mechanical drift is detected
+ *         during normal operation: the next sync runs the sensor search.
  *
  */
 void resetMechPosition(void) {
-	setMechPosition(0, 0);
+	uint32_t state = mechStateWithPosition(getMechState(), 0, 0);
+	setMechState(state & ~(RTC_BKP_FLAG_POS_VALID | RTC_BKP_FLAG_STEP_BUSY));
 }
 
 /**
- * @brief  Read last tick/tock state from backup register DR2 (bit 0).
+ * @brief  Overwrite the mechanical position after a sensor-based correction.
  *
- *         The mechanical clock coil alternates between two pins (tick/tock)
- *         on each minute advance. This state must persist across power cycles
- *         to keep the alternation in sync with the mechanical mechanism.
+ *         Unlike resetMechPosition() the journal flags are kept: the new
+ *         position is as trustworthy as the sensor edge that produced it.
  *
- * @return 0 = last was tick (next should be tock), 1 = last was tock
+ * @param  hours    Corrected hour position (0-23)
+ * @param  minutes  Corrected minute position (0-59)
  */
-uint8_t getLastTick(void) {
-	uint32_t flags = HAL_RTCEx_BKUPRead(hrtcHandle, RTC_BKP_FLAGS);
-	return (flags & RTC_BKP_FLAG_LAST_TICK) ? 1 : 0;
+void correctMechPosition(uint8_t hours, uint8_t minutes) {
+	setMechState(mechStateWithPosition(getMechState(), hours, minutes));
 }
 
 /**
- * @brief  Write last tick/tock state to backup register DR2 (bit 0).
+ * @brief  Record the 00:00 position found by the sensors as valid.
  *
- *         Uses read-modify-write to preserve other flag bits in DR2.
+ *         Called at the end of searchForZeroPosition(). From here on every
+ *         committed step keeps the position valid across power cycles.
  *
- * @param  tickState  0 = tick, 1 = tock
  */
-void setLastTick(uint8_t tickState) {
-	uint32_t flags = HAL_RTCEx_BKUPRead(hrtcHandle, RTC_BKP_FLAGS);
-
-	if (tickState) {
-		flags |= RTC_BKP_FLAG_LAST_TICK;
-	} else {
-		flags &= ~RTC_BKP_FLAG_LAST_TICK;
-	}
+void markMechZero(void) {
+	uint32_t state = mechStateWithPosition(getMechState(), 0, 0);
+	setMechState((state | RTC_BKP_FLAG_POS_VALID) & ~RTC_BKP_FLAG_STEP_BUSY);
+}
 
-	HAL_RTCEx_BKUPWrite(hrtcHandle, RTC_BKP_FLAGS, flags);
+/**
+ * @brief  Read last tick/tock state from the cached state word.
+ *
+ *         The mechanical clock coil alternates between two pins (tick/tock)
+ *         on each minute advance. This state must persist across power cycles
+ *         to keep the alternation in sync with the mechanical mechanism;
+ *         incrementMechMinute() flips it together with the position.
+ *
+ * @return 0 = last was tick (next should be tock), 1 = last was tock
+ */
+uint8_t getLastTick(void) {
+	return (getMechState() & RTC_BKP_FLAG_LAST_TICK) ? 1 : 0;
 }
 
 /**
@@ -253,6 +401,147 @@ void applyCalibration(void) {
 }
 
 
+/*
+ * ################################
+ * #   WEEKLY SILENT SCHEDULE     #
+ * ################################
+ */
+
+/**
+ * @brief  Map an RTC weekday to a schedule index, without a division.
+ *
+ * @param  weekDay  RTC_WEEKDAY_MONDAY (1) - RTC_WEEKDAY_SUNDAY (7)
+ * @return Day index 0-6 (Monday for out of range values)
+ */
+static uint8_t silentDayIndex(uint8_t weekDay) {
+	uint8_t d = weekDay - 1;
+	return (d < SILENT_DAYS) ? d : 0;
+}
+
+/**
+ * @brief  Hour bitmap of a silent window (start:01 to end:00).
+ *
+ *         Bit h is set when hour h belongs to the window; the window may
+ *         wrap around midnight. start == end gives an empty window.
+ *
+ * @param  start  Hour when the silent period begins (0-23)
+ * @param  end    Hour when the silent period ends (0-23)
+ * @return 24-bit hour map
+ */
+static uint32_t silentWindowMap(uint8_t start, uint8_t end) {
+	uint32_t map = 0;
+
+	for (uint8_t h = start; h != end; h = (h == 23) ? 0 : h + 1) {
+		map |= 1UL << h;
+	}
+	return map;
+}
+
+/**
+ * @brief  Rebuild the lookup maps used by isSilentAt().
+ *
+ *         Each lookup map is the day's hour map shifted up by one, with the
+ *         previous day's hour 23 in bit 0. Hour h then sits at bit h+1 and
+ *         the hour before it at bit h, so the HH:00 rule (silent only when
+ *         the previous hour was silent too) needs no wrap-around branch.
+ *
+ */
+static void silentMapRefresh(void) {
+	for (uint8_t d = 0; d < SILENT_DAYS; d++) {
+		uint8_t prev = (d == 0) ? (SILENT_DAYS - 1) : (d - 1);
+		silentLookup[d] = (silentMap[d] << 1) | ((silentMap[prev] >> 23) & 1);
+	}
+}
+
+/**
+ * @brief  Apply a FLASH_REC_SILENT_DAY record to the RAM map.
+ *
+ *         Called by flashLogScan() for each record in log order, so the
+ *         latest record of a day wins. Day 0 (SILENT_ALL_DAYS) sets every day.
+ *
+ * @param  payload  Record payload: hour map[23:0] | weekday[26:24]
+ */
+static void silentApplyRecord(uint32_t payload) {
+	uint8_t day = (uint8_t)((payload >> FLASH_SILENT_DAY_SHIFT) & 0x7);
+	uint32_t map = payload & SILENT_HOURS_MASK;
+
+	for (uint8_t d = 0; d < SILENT_DAYS; d++) {
+		if ((day == SILENT_ALL_DAYS) || (day == d + 1)) {
+			silentMap[d] = map;
+		}
+	}
+}
+
+/**
+ * @brief  Read the hour map of one weekday.
+ *
+ * @param  weekDay  RTC_WEEKDAY_MONDAY (1) - RTC_WEEKDAY_SUNDAY (7)
+ * @return 24-bit hour map, bit h set = hour h silent
+ */
+uint32_t getSilentDayMap(uint8_t weekDay) {
+	return silentMap[silentDayIndex(weekDay)];
+}
+
+/**
+ * @brief  Set or clear one hour of the weekly schedule.
+ *
+ *         The change is live at once; the day is marked for the next
+ *         deferred Flash write (flashScheduleSettings).
+ *
+ * @param  weekDay  RTC_WEEKDAY_MONDAY (1) - RTC_WEEKDAY_SUNDAY (7)
+ * @param  hour     Hour to change (0-23)
+ * @param  silent   1 = silent, 0 = ticking
+ */
+void setSilentDayHour(uint8_t weekDay, uint8_t hour, uint8_t silent) {
+	uint8_t d = silentDayIndex(weekDay);
+
+	if (silent) {
+		silentMap[d] |= 1UL << hour;
+	} else {
+		silentMap[d] &= ~(1UL << hour);
+	}
+	silentMapRefresh();
+	silentDirty |= 1 << (d + 1);
+}
+
+/**
+ * @brief  Copy the daily window in DR3 to every day of the week.
+ *
+ *         Called when the HH-HH editor commits: the window replaces all the
+ *         per-day maps, and a single all-days record is queued for Flash.
+ *
+ */
+void silentApplyWindow(void) {
+	uint32_t map = silentWindowMap(getSilentStartHour(), getSilentEndHour());
+
+	for (uint8_t d = 0; d < SILENT_DAYS; d++) {
+		silentMap[d] = map;
+	}
+	silentMapRefresh();
+	silentDirty = SILENT_DIRTY_ALL;
+}
+
+/**
+ * @brief  Check if a time falls within the weekly silent schedule.
+ *
+ *         One shift and one mask on the day's lookup map (silentMapRefresh):
+ *         minutes 01-59 test the hour bit, HH:00 tests the hour and the one
+ *         before it, so the clock still ticks to the first silent hour's :00
+ *         and only goes quiet from HH:01, as with the single window.
+ *
+ *         Called by the time service when it publishes a snapshot.
+ *
+ * @param  weekDay  RTC_WEEKDAY_MONDAY (1) - RTC_WEEKDAY_SUNDAY (7)
+ * @param  hours    Hour to check (0-23)
+ * @param  minutes  Minute to check (0-59)
+ * @return 1 if the time is inside the silent schedule, 0 otherwise
+ */
+uint8_t isSilentAt(uint8_t weekDay, uint8_t hours, uint8_t minutes) {
+	uint32_t mask = minutes ? 0x2 : 0x3;
+	return (((silentLookup[silentDayIndex(weekDay)] >> hours) & mask) == mask);
+}
+
+
 /*
  * ################################
  * #    FLASH SETTINGS STORAGE    #
@@ -260,25 +549,290 @@ void applyCalibration(void) {
  */
 
 /**
- * @brief  Persist silent hours and calibration to Flash (page 31).
+ * @brief  Base address of a settings slot.
  *
- *         Reads current settings from backup registers and writes them as
- *         a single 64-bit double-word to the last Flash page (0x0800F800).
+ * @param  page  Slot index (0 = page 30, 1 = page 31)
+ * @return Pointer to the first word of the page
+ */
+static uint32_t *flashPageAddr(uint8_t page) {
+	return (uint32_t *)(FLASH_SETTINGS_ADDR + ((uint32_t)page * FLASH_PAGE_SIZE));
+}
+
+/**
+ * @brief  CRC-8 of a log record (payload bytes, then type).
  *
- *         Data layout:
- *           word0 [31:0]:  silentStart[7:0] | silentEnd[15:8] | calibRaw[31:16]
- *           word1 [63:32]: magic number 0xC1F5A001 (validates data on read)
+ *         Bitwise implementation: five bytes per record do not justify a
+ *         256-byte table in a 64K part.
+ *
+ * @param  type     Record type (flashRecEnum)
+ * @param  payload  Record payload (word0)
+ * @return CRC-8 (poly FLASH_CRC8_POLY, init 0)
+ */
+static uint8_t flashCrc8(uint8_t type, uint32_t payload) {
+	uint8_t crc = 0;
+
+	for (uint8_t i = 0; i < 5; i++) {
+		crc ^= (i < 4) ? (uint8_t)(payload >> (i * 8)) : type;
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ FLASH_CRC8_POLY) : (uint8_t)(crc << 1);
+		}
+	}
+	return crc;
+}
+
+/**
+ * @brief  Validate a log record and extract its type.
+ *
+ * @param  rec       Pointer to the record (word0, word1)
+ * @param[out] type  Record type, written only when the record is valid
+ * @return 1 if tag and CRC match, 0 otherwise (erased, torn or foreign)
+ */
+static uint8_t flashRecordValid(const uint32_t *rec, uint8_t *type) {
+	uint8_t recType = (uint8_t)(rec[1] & 0xFF);
+
+	if ((rec[1] & FLASH_LOG_TAG_MASK) != FLASH_LOG_TAG) {
+		return 0;
+	}
+	if ((uint8_t)(rec[1] >> 8) != flashCrc8(recType, rec[0])) {
+		return 0;
+	}
+	*type = recType;
+	return 1;
+}
+
+/**
+ * @brief  Find the active slot, the end of its log and the latest settings.
+ *
+ *         The active slot is the page whose header (slot 0) is valid and
+ *         carries the highest sequence number. Records are appended in order,
+ *         so the first double-word still erased (both words 0xFFFFFFFF) is
+ *         the next free slot; records failing the CRC are skipped but still
+ *         count as used.
+ *
+ *         With no valid header anywhere, the single record written by older
+ *         firmware at the start of page 31 is accepted as the settings.
+ *
+ *         The isSilentAt() lookup maps are rebuilt on every exit, also when
+ *         no log page exists and the maps hold only the DR3 window.
+ *
+ *         The result is cached in RAM: the pages are scanned once per boot.
+ *
+ */
+static void flashLogScan(void) {
+	uint32_t *addr;
+	uint8_t type;
+	int16_t i;
+
+	flashLogPage = FLASH_PAGE_NONE;
+	flashSettingsValid = 0;
+
+	for (uint8_t page = 0; page < FLASH_SETTINGS_PAGES; page++) {
+		addr = flashPageAddr(page);
+		if (flashRecordValid(addr, &type) && (type == FLASH_REC_HEADER)) {
+			if ((flashLogPage == FLASH_PAGE_NONE) || ((int32_t)(addr[0] - flashLogSeq) > 0)) {
+				flashLogPage = page;
+				flashLogSeq = addr[0];
+			}
+		}
+	}
+
+	if (flashLogPage == FLASH_PAGE_NONE) {
+		addr = (uint32_t *)FLASH_LEGACY_ADDR;
+		if (addr[1] == FLASH_LEGACY_MAGIC) {
+			flashSettingsLast = addr[0];
+			flashSettingsValid = 1;
+		}
+		flashLogSeq = 0;
+		flashLogNext = FLASH_LOG_RECORDS;	// First append opens a slot
+		silentMapRefresh();					// Maps from the DR3 window alone
+		return;
+	}
+
+	addr = flashPageAddr(flashLogPage);
+	for (i = 1; i < FLASH_LOG_RECORDS; i++) {
+		uint32_t *rec = &addr[i * 2];
+
+		if ((rec[0] == FLASH_LOG_ERASED) && (rec[1] == FLASH_LOG_ERASED)) {
+			break;
+		}
+		if (flashRecordValid(rec, &type)) {
+			if (type == FLASH_REC_SETTINGS) {
+				flashSettingsLast = rec[0];
+				flashSettingsValid = 1;
+			} else if (type == FLASH_REC_SILENT_DAY) {
+				silentApplyRecord(rec[0]);
+			}
+		}
+	}
+	flashLogNext = i;
+	silentMapRefresh();
+}
+
+/**
+ * @brief  Program one record (word1 built from type and CRC).
+ *
+ *         HAL_FLASH_Program() clears the error flags it reports; a failed
+ *         double-word may still be half programmed, which its CRC rejects.
+ *
+ * @param  addr     Flash address of the double-word
+ * @param  type     Record type (flashRecEnum)
+ * @param  payload  Record payload (word0)
+ * @return 1 = programmed, 0 = Flash error
+ */
+static uint8_t flashRecordProgram(uint32_t addr, uint8_t type, uint32_t payload) {
+	uint32_t word1 = FLASH_LOG_TAG | ((uint32_t)flashCrc8(type, payload) << 8) | type;
+	return (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, addr, (uint64_t)payload | ((uint64_t)word1 << 32)) == HAL_OK);
+}
+
+/**
+ * @brief  Switch the log to the other slot (A/B), carrying the settings.
+ *
+ *         The inactive page is erased, the latest settings are copied into
+ *         slot 1, the seven weekly silent day maps after it, and only then the header with the next sequence number is
+ *         programmed into slot 0. The header is the commit: until it is
+ *         written the old page stays the active one, so a brown-out at any
+ *         point leaves one complete copy of the settings and the next boot
+ *         needs no recovery. The half-written page is simply erased again by
+ *         the next switch.
+ *
+ *         A failed erase or program leaves the old page active and the log
+ *         full (flashLogNext unchanged), so the next append tries the switch
+ *         again; the target page is never programmed without a good erase.
+ *         Error flags left over from an earlier failure (e.g. PROGERR after
+ *         a brown-out) would fail the erase at once: flashLogProgram() clears
+ *         them first.
  *
  *         STM32G0 Flash notes:
- *         - Erase unit is one page (2 KB). The full page is erased each time.
- *         - Program unit is one double-word (64 bits, 8 bytes).
- *         - Flash endurance is ~10,000 erase cycles (fine for rare settings changes).
- *         - HAL_FLASH_Unlock/Lock: the Flash control register is write-protected
- *           by default; Unlock removes protection, Lock restores it.
+ *         - Erase unit is one page (2 KB), ~22-40 ms.
+ *         - Program unit is one double-word (64 bits, 8 bytes), ~85 us.
+ *         - Flash endurance is ~10,000 erase cycles per page.
  *
- *         RTOS: taskENTER_CRITICAL() disables interrupts during the Flash
- *         operation (~40ms erase). On single-bank STM32G0 the CPU stalls on
- *         Flash reads during erase anyway, so this is mainly defensive.
+ * @return 1 = switched, 0 = Flash error (old page still active)
+ */
+static uint8_t flashLogOpenPage(void) {
+	FLASH_EraseInitTypeDef eraseInit;
+	uint32_t pageError;
+	uint8_t target = (flashLogPage == FLASH_PAGE_NONE) ? 0 : !flashLogPage;
+	uint32_t base = (uint32_t)flashPageAddr(target);
+	int16_t next = 1;
+
+	eraseInit.TypeErase = FLASH_TYPEERASE_PAGES;
+	eraseInit.Page = FLASH_SETTINGS_PAGE + target;
+	eraseInit.NbPages = 1;
+	if ((HAL_FLASHEx_Erase(&eraseInit, &pageError) != HAL_OK) || (pageError != 0xFFFFFFFFU)) {
+		return 0;
+	}
+
+	if (flashSettingsValid) {
+		if (!flashRecordProgram(base + 8, FLASH_REC_SETTINGS, flashSettingsLast)) {
+			return 0;
+		}
+		next++;
+	}
+	for (uint8_t d = 0; d < SILENT_DAYS; d++) {
+		if (!flashRecordProgram(base + (next * 8), FLASH_REC_SILENT_DAY,
+				silentMap[d] | ((uint32_t)(d + 1) << FLASH_SILENT_DAY_SHIFT))) {
+			return 0;
+		}
+		next++;
+	}
+
+	if (!flashRecordProgram(base, FLASH_REC_HEADER, flashLogSeq + 1)) {
+		return 0;
+	}
+	flashLogSeq++;
+	flashLogPage = target;
+	flashLogNext = next;
+	return 1;
+}
+
+/**
+ * @brief  Program one log record at the end of the active slot.
+ *
+ *         When the slot is full (or none exists yet) the log moves to the
+ *         other page first (flashLogOpenPage): this is the only erase, once
+ *         every FLASH_LOG_RECORDS appends.
+ *
+ *         Must be called with the scheduler suspended (see flashLogAppend).
+ *
+ *         HAL_FLASH_Unlock/Lock: the Flash control register is write-protected
+ *         by default; Unlock removes protection, Lock restores it.
+ *
+ *         On a failed program the slot is reused by the next append while
+ *         it still reads erased; a half-programmed slot is skipped (its CRC
+ *         fails, flashLogScan() ignores it).
+ *
+ * @param  type     Record type (flashRecEnum)
+ * @param  payload  Record payload (word0)
+ * @return 1 = record written, 0 = Flash error
+ */
+static uint8_t flashLogProgram(uint8_t type, uint32_t payload) {
+	uint32_t *rec;
+	uint8_t ok = 0;
+
+	HAL_FLASH_Unlock();
+	FLASH->SR = FLASH_SR_ERRORS;	// Leftovers of an earlier failure would fail this program
+
+	if ((flashLogNext < FLASH_LOG_RECORDS) || flashLogOpenPage()) {
+		rec = flashPageAddr(flashLogPage) + (flashLogNext * 2);
+		ok = flashRecordProgram((uint32_t)rec, type, payload);
+		if (ok || (rec[0] != FLASH_LOG_ERASED) || (rec[1] != FLASH_LOG_ERASED)) {
+			flashLogNext++;
+		}
+	}
+
+	HAL_FLASH_Lock();
+	return ok;
+}
+
+/**
+ * @brief  Append a record to the Flash log (scheduler suspended).
+ *
+ *         RTOS: vTaskSuspendAll() keeps the other tasks away from the Flash
+ *         controller and the log state without disabling interrupts, so an
+ *         ordinary append (one double-word program) delays the ISRs only by
+ *         the Flash read stall. Ticks occurring meanwhile are replayed by
+ *         xTaskResumeAll().
+ *
+ * @param  type     Record type (flashRecEnum)
+ * @param  payload  Record payload (word0)
+ * @return 1 = stored (or settings unchanged), 0 = Flash error
+ */
+static uint8_t flashLogAppend(uint8_t type, uint32_t payload) {
+	uint8_t ok = 1;
+
+	vTaskSuspendAll();
+	if (flashLogNext < 0) {
+		flashLogScan();
+	}
+	if ((type != FLASH_REC_SETTINGS) || !flashSettingsValid || (payload != flashSettingsLast)) {
+		ok = flashLogProgram(type, payload);
+		if (ok && (type == FLASH_REC_SETTINGS)) {
+			flashSettingsLast = payload;
+			flashSettingsValid = 1;
+		}
+	}
+	xTaskResumeAll();
+	return ok;
+}
+
+/**
+ * @brief  Persist silent hours and calibration to Flash (pages 30-31).
+ *
+ *         Reads current settings from backup registers and appends them as
+ *         a FLASH_REC_SETTINGS record to the Flash log. Nothing is written
+ *         when the settings equal the latest record in the page. Then the
+ *         weekly silent days changed since the last write are appended as
+ *         FLASH_REC_SILENT_DAY records (a single all-days record after the
+ *         HH-HH window was applied).
+ *
+ *         After a Flash error the failed records stay pending: the settings
+ *         record is still different from the last stored one, and the silent
+ *         days are marked dirty again, so the next write retries them.
+ *
+ *         Data layout:
+ *           word0 [31:0]:  silentStart[7:0] | silentEnd[15:8] | calibRaw[31:16]
+ *           word1 [63:32]: tag 0xC1F5 | CRC-8 | FLASH_REC_SETTINGS
  *
  */
 void flashWriteSettings(void) {
@@ -292,51 +846,167 @@ void flashWriteSettings(void) {
 	uint32_t word0 = (uint32_t)silentStart
 					| ((uint32_t)silentEnd << 8)
 					| (calibRaw << 16);
-	uint64_t data = (uint64_t)word0 | ((uint64_t)FLASH_SETTINGS_MAGIC << 32);
 
-	FLASH_EraseInitTypeDef eraseInit;
-	uint32_t pageError;
+	flashLogAppend(FLASH_REC_SETTINGS, word0);
 
 	taskENTER_CRITICAL();
+	uint8_t dirty = silentDirty;
+	silentDirty = 0;
+	taskEXIT_CRITICAL();
 
-	HAL_FLASH_Unlock();
+	if (dirty & SILENT_DIRTY_ALL) {
+		// Payload from the window itself: silentMap[0] may already hold a Monday edit made since
+		if (flashLogAppend(FLASH_REC_SILENT_DAY, silentWindowMap(silentStart, silentEnd))) {	// Days edited after it follow
+			dirty &= ~SILENT_DIRTY_ALL;
+		}
+	}
+	for (uint8_t d = 0; d < SILENT_DAYS; d++) {
+		if (dirty & (1 << (d + 1))) {
+			if (flashLogAppend(FLASH_REC_SILENT_DAY, silentMap[d] | ((uint32_t)(d + 1) << FLASH_SILENT_DAY_SHIFT))) {
+				dirty &= ~(1 << (d + 1));
+			}
+		}
+	}
 
-	eraseInit.TypeErase = FLASH_TYPEERASE_PAGES;
-	eraseInit.Page = FLASH_SETTINGS_PAGE;
-	eraseInit.NbPages = 1;
-	HAL_FLASHEx_Erase(&eraseInit, &pageError);
+	if (dirty) {
+		taskENTER_CRITICAL();
+		silentDirty |= dirty;
+		taskEXIT_CRITICAL();
+	}
+}
 
-	HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, FLASH_SETTINGS_ADDR, data);
+/**
+ * @brief  Timer daemon callback: write the pending settings to Flash.
+ *
+ * @param  timer  Handle of flashSettingsTimer (unused)
+ */
+static void flashSettingsTimerCallback(TimerHandle_t timer) {
+	flashWriteSettings();
+}
 
-	HAL_FLASH_Lock();
+/**
+ * @brief  Create the one-shot timer used by flashScheduleSettings().
+ *
+ *         Called from createRTOS_Tasks() before the scheduler starts.
+ *
+ *         xTimerCreate(name, period, autoReload, id, callback): allocates a
+ *         software timer from the FreeRTOS heap. The callback runs in the
+ *         timer daemon task (configTIMER_TASK_PRIORITY, below the
+ *         application tasks), never in interrupt context.
+ *
+ */
+void flashSettingsTimerInit(void) {
+	flashSettingsTimer = xTimerCreate("Flash", pdMS_TO_TICKS(FLASH_WRITE_DELAY), pdFALSE, NULL, flashSettingsTimerCallback);
+	configASSERT(flashSettingsTimer != NULL);
+}
 
-	taskEXIT_CRITICAL();
+/**
+ * @brief  Request a deferred write of the settings to Flash.
+ *
+ *         The backup registers already hold the new values, so the Flash
+ *         copy (only needed after a battery loss) can wait: the write is
+ *         done by the timer daemon FLASH_WRITE_DELAY ms after the LAST
+ *         request, so several changes in a row cost one Flash operation
+ *         and the caller (displayTask) never waits for the Flash.
+ *
+ *         xTimerReset(timer, 0): (re)starts the timer from now; 0 = don't
+ *         block if the timer command queue is full.
+ *
+ */
+void flashScheduleSettings(void) {
+	xTimerReset(flashSettingsTimer, 0);
+}
+
+/**
+ * @brief  Timer daemon callback: append an event record to the Flash log.
+ *
+ * @param  type     Record type, passed as the pointer parameter
+ * @param  payload  Record payload
+ */
+static void flashLogEventCallback(void *type, uint32_t payload) {
+	flashLogAppend((uint8_t)(uintptr_t) type, payload);
+}
+
+/**
+ * @brief  Append an event record (resync, power up) to the Flash log.
+ *
+ *         The append (log scan, page erase, Flash program) runs in the timer
+ *         daemon, like the settings write: its stack is sized for the Flash
+ *         path, the caller's (clockTask) is not. Records and settings writes
+ *         are serialized by the daemon, in the order they were requested.
+ *
+ *         xTimerPendFunctionCall(function, param1, param2, wait): queues the
+ *         call on the timer command queue; waits up to FLASH_LOG_QUEUE_WAIT
+ *         ms if the queue is full (the daemon drains it as soon as the caller
+ *         blocks). Must be called from a task.
+ *
+ * @param  type     Record type (FLASH_REC_RESYNC, FLASH_REC_POWER_UP)
+ * @param  payload  Record payload, see flashRecEnum
+ */
+void flashLogEvent(uint8_t type, uint32_t payload) {
+	xTimerPendFunctionCall(flashLogEventCallback, (void *)(uintptr_t) type, payload, pdMS_TO_TICKS(FLASH_LOG_QUEUE_WAIT));
+}
+
+/**
+ * @brief  Number of records currently stored in the active Flash slot.
+ *
+ * @return Records after the header (0-FLASH_LOG_RECORDS-1)
+ */
+uint16_t flashLogCount(void) {
+	if (flashLogNext < 0) {
+		flashLogScan();
+	}
+	return (flashLogPage == FLASH_PAGE_NONE) ? 0 : (uint16_t)(flashLogNext - 1);
+}
+
+/**
+ * @brief  Read back a record of the Flash log (oldest first).
+ *
+ *         The Flash is memory mapped, so reading needs no lock.
+ *
+ * @param  index         Record index (0 = oldest after the header)
+ * @param[out] type      Record type (flashRecEnum)
+ * @param[out] payload   Record payload
+ * @return 1 if the record is valid, 0 if out of range or the CRC fails
+ */
+uint8_t flashLogRead(uint16_t index, uint8_t *type, uint32_t *payload) {
+	uint32_t *rec;
+
+	if (index >= flashLogCount()) {
+		return 0;
+	}
+	rec = &flashPageAddr(flashLogPage)[(index + 1) * 2];
+	if (!flashRecordValid(rec, type)) {
+		return 0;
+	}
+	*payload = rec[0];
+	return 1;
 }
 
 /**
  * @brief  Restore settings from Flash to backup registers on battery-loss boot.
  *
  *         Called from createRTOS_Tasks() when ICSR.INITS == 0 (RTC lost power).
- *         Reads the double-word at FLASH_SETTINGS_ADDR, validates the magic
- *         number, and writes silent hours and calibration to backup registers.
- *         If the magic doesn't match (Flash never written = fresh device),
- *         writes factory defaults to the backup registers.
+ *         Picks the slot with the newest valid header, takes its latest
+ *         settings record with a matching CRC and writes silent hours and
+ *         calibration to backup registers. If no settings record exists
+ *         (Flash never written = fresh device), writes factory defaults to
+ *         the backup registers.
  *
  *         Called before the scheduler starts, so no critical section needed.
  *
  */
 void flashRestoreSettings(void) {
-	uint32_t *addr = (uint32_t *)FLASH_SETTINGS_ADDR;
-	uint32_t word0 = addr[0];
-	uint32_t word1 = addr[1];
+	flashLogScan();
 
-	if (word1 != FLASH_SETTINGS_MAGIC) {
+	if (!flashSettingsValid) {
 		// Fresh device: write defaults to backup registers
 		setSilentHours(SILENT_DEFAULT_START, SILENT_DEFAULT_END);
 		setCalibration(0, 0);
 		return;
 	}
 
+	uint32_t word0 = flashSettingsLast;
 	uint8_t silentStart = (uint8_t)(word0 & 0xFF);
 	uint8_t silentEnd = (uint8_t)((word0 >> 8) & 0xFF);
 	uint16_t calibRaw = (uint16_t)((word0 >> 16) & 0x3FF);
@@ -358,33 +1028,69 @@ void flashRestoreSettings(void) {
  */
 
 /**
- * @brief  Check if current RTC time falls within the silent period.
+ * @brief  Load the weekly silent schedule into RAM.
  *
- *         Silent period is defined by start/end hours in backup register DR3.
- *         The check triggers at HH:01 (not HH:00), so the clock can tick to
- *         the exact start hour before going silent.
+ *         Called from createRTOS_Tasks() on every boot, after the settings
+ *         were restored. The 7x24 bitmap (168 bits) does not fit the spare
+ *         backup registers, so it lives in RAM: every day starts from the
+ *         daily window in DR3, then the FLASH_REC_SILENT_DAY records of the
+ *         log are replayed over it (flashLogScan).
  *
- *         Handles wrap-around midnight (e.g. 22:01→09:00) and same-day
- *         ranges (e.g. 02:01→05:00).
+ */
+void silentScheduleInit(void) {
+	uint32_t map = silentWindowMap(getSilentStartHour(), getSilentEndHour());
+
+	for (uint8_t d = 0; d < SILENT_DAYS; d++) {
+		silentMap[d] = map;
+	}
+	flashLogScan();
+}
+
+/**
+ * @brief  Check if the current time falls within the silent period.
  *
- *         STM32 RTC note: HAL_RTC_GetTime() MUST be followed by
- *         HAL_RTC_GetDate() — the date read unlocks the time shadow registers.
- *         Skipping GetDate causes GetTime to return stale values.
+ *         Reads the flag of the published time snapshot (timeGetSnapshot),
+ *         so it does not touch the RTC.
  *
  * @return 1 if currently in silent period, 0 otherwise
  */
 uint8_t isInSilentPeriod(void) {
-    HAL_RTC_GetTime(hrtcHandle, &RTC_Time, RTC_FORMAT_BIN);
-	HAL_RTC_GetDate(hrtcHandle, &RTC_Date, RTC_FORMAT_BIN);
-	uint8_t start = getSilentStartHour();
-	uint8_t end = getSilentEndHour();
-	uint8_t pastStart = (RTC_Time.Hours > start)
-			|| (RTC_Time.Hours == start && RTC_Time.Minutes > 0);
-	if (start > end) {
-		// Wraps around midnight (e.g., 22:01 to 09:00)
-		return (pastStart || RTC_Time.Hours < end);
-	} else {
-		// Same day (e.g., 02:01 to 05:00)
-		return (pastStart && RTC_Time.Hours < end);
-	}
+	timeSnapshot_t now;
+	timeGetSnapshot(&now);
+	return now.silent;
+}
+
+/*
+ * ################################
+ * #     SUB-SECOND HELPERS       #
+ * ################################
+ */
+
+/**
+ * @brief  Read the RTC and return the time left to the next minute in ms.
+ *
+ *         The seconds come from TR, the fraction of the current second from
+ *         the synchronous prescaler down-counter SSR, which counts from
+ *         PREDIV_S (255, so 3.9ms resolution) down to 0 during each second.
+ *         HAL_RTC_GetTime() reads SSR before TR, as the reference manual
+ *         requires, and returns them as SubSeconds and SecondFraction.
+ *         With PREDIV_S + 1 a power of two (RTC_SUBSEC_BITS) the fraction
+ *         scales to ms with a shift, and BCD seconds need no division.
+ *
+ *         The read pair runs in a critical section: the time service alarm
+ *         interrupt must not read the RTC between the TR and DR reads.
+ *
+ * @return Milliseconds to the next HH:MM:00 boundary (1-60000)
+ */
+uint16_t rtcMsToNextMinute(void) {
+	RTC_TimeTypeDef rtcTime;
+	RTC_DateTypeDef rtcDate;
+
+	taskENTER_CRITICAL();
+	HAL_RTC_GetTime(hrtcHandle, &rtcTime, RTC_FORMAT_BCD);
+	HAL_RTC_GetDate(hrtcHandle, &rtcDate, RTC_FORMAT_BCD);
+	taskEXIT_CRITICAL();
+
+	uint32_t subMs = ((rtcTime.SubSeconds + 1) * 1000) >> RTC_SUBSEC_BITS;
+	return (uint16_t)((59 - bcdToBin(rtcTime.Seconds)) * 1000 + subMs);
 }
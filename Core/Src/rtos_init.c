@@ -17,6 +17,8 @@
 #include "display_task.h"
 #include "button_task.h"
 #include "clock_task.h"
+#include "time_service.h"
+#include "sys_clock.h"
 
 
 /*
@@ -54,8 +56,14 @@ void initRTOS_Periferals(TIM_HandleTypeDef *htim, RTC_HandleTypeDef *hrtc) {
  *         Initialization steps:
  *         1. Check ICSR.INITS bit — if 0, the RTC lost power (battery removed).
  *            In that case, restore silent hours and calibration from Flash.
- *         2. Reset mechanical position to 00:00 (forces sensor search on sync).
- *         3. Apply RTC smooth calibration from backup register to hardware.
+ *            Then load the weekly silent schedule (DR3 window + Flash days).
+ *         2. Unless the RTC kept power and the position journal in DR0 is
+ *            clean (valid, no step in flight), reset mechanical position to
+ *            00:00 (forces sensor search on sync).
+ *         3. Apply RTC smooth calibration from backup register to hardware,
+ *            start the time service (first snapshot + 1 Hz RTC alarm),
+ *            create the deferred Flash settings write timer, then drop
+ *            the system clock to its idle level (HSI16).
  *         4. Create 3 tasks (displayTask, buttonTask, clockTask) with
  *            configASSERT to halt on creation failure.
  *         5. Suspend buttonTask — buttons are disabled until clockTask
@@ -84,11 +92,22 @@ void createRTOS_Tasks() {
 		flashRestoreSettings();
 	}
 
-    resetMechPosition();    // Force in startup to search for 0 in order to sincronize the Tick Tock
+	silentScheduleInit();	// Weekly silent schedule: DR3 window + Flash day records
+
+	// Warm boot with a clean journal: trust DR0 and fast sync, otherwise search for 0
+	if (!clockTaskInitState || !isMechPositionValid()) {
+		resetMechPosition();
+	}
 	applyCalibration();		// Apply RTC smooth calibration from backup register
+	timeServiceInit();		// First time snapshot, then one per second (RTC alarm A)
+	flashSettingsTimerInit();	// Deferred Flash settings write (timer daemon)
+	sysClockInit();			// Idle on HSI16 from here on, PLL on demand
 
 	// FreeRTOS - Tasks Creation/
-	configASSERT(xTaskCreate(displayTask, "Display Task", 120, NULL, 2, &displayTaskHandle) == pdPASS);
+	// Display stack (words): deepest path is a diag page render (formatting, blit with its
+	// generator, I2C transfer and ssd1306_Recover) or sysClockBoost (RCC switch, HAL_InitTick),
+	// about 115 with the context and an exception frame. Check "STD" after changing them.
+	configASSERT(xTaskCreate(displayTask, "Display Task", 160, NULL, 2, &displayTaskHandle) == pdPASS);
 	configASSERT(xTaskCreate(buttonTask, "Button Task", 80, NULL, 2, &buttonTaskHandle) == pdPASS);
 	configASSERT(xTaskCreate(clockTask, "Clock Task", 120, (void *)(uintptr_t) clockTaskInitState, 2, &clockTaskHandle) == pdPASS);
 
@@ -58,6 +58,7 @@
 extern TIM_HandleTypeDef htim17;
 
 /* USER CODE BEGIN EV */
+extern RTC_HandleTypeDef hrtc;
 
 /* USER CODE END EV */
 
@@ -131,4 +132,31 @@ void TIM17_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles EXTI line 2 and line 3 interrupts (BTN_DEC wake from STOP).
+  */
+void EXTI2_3_IRQHandler(void)
+{
+  HAL_GPIO_EXTI_IRQHandler(BTN_DEC_Pin);
+}
+
+/**
+  * @brief This function handles EXTI line 4 to 15 interrupts (BTN_INC, BTN_SET, SNS_HOUR, SNS_DAY).
+  */
+void EXTI4_15_IRQHandler(void)
+{
+  HAL_GPIO_EXTI_IRQHandler(BTN_INC_Pin);
+  HAL_GPIO_EXTI_IRQHandler(BTN_SET_Pin);
+  HAL_GPIO_EXTI_IRQHandler(SNS_HOUR_Pin);
+  HAL_GPIO_EXTI_IRQHandler(SNS_DAY_Pin);
+}
+
+/**
+  * @brief This function handles RTC and TAMP interrupts (alarm A time service, alarm B end of silence).
+  */
+void RTC_TAMP_IRQHandler(void)
+{
+  HAL_RTC_AlarmIRQHandler(&hrtc);
+}
+
 /* USER CODE END 1 */
@@ -0,0 +1,196 @@
+/**
+ * @file   sys_clock.c
+ * @brief  System clock scaling: HSI16 while idle, PLL 64 MHz for display
+ *         rendering and servo strokes.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include "rtos_init.h"
+#include "sys_clock.h"
+#include "sys_stats.h"
+
+
+// Users currently holding the fast clock (sysClockUserEnum bits)
+static uint8_t sysClockUsers;
+
+
+/**
+ * @brief  Bring the timers back to their nominal rates after a clock change.
+ *
+ *         SystemCoreClock has just been updated by HAL_RCC_ClockConfig(),
+ *         which also re-initialized the HAL time base (TIM17) through
+ *         HAL_InitTick(). The other clock-dependent peripherals are:
+ *         - TIM1 (servo PWM): prescaler for SYSCLK_SERVO_TIMER_HZ, so the
+ *           SERVO_xxx_PWM compare values keep their meaning
+ *         - TIM3 (coil drive): prescaler for COIL_TIMER_HZ, so the hold PWM
+ *           keeps its frequency and duty; a pulse in progress only sees one
+ *           restarted PWM period
+ *         - TIM2 (run time statistics): prescaler for STATS_TIMER_HZ; the
+ *           count is carried over the update event that loads the prescaler,
+ *           so the microsecond timestamps stay continuous
+ *         - SysTick (FreeRTOS tick): reload for configTICK_RATE_HZ; the
+ *           part of the tick period still to run is scaled to the new clock
+ *           and loaded as a one-off reload (a write to VAL only clears it),
+ *           so a switch neither shortens nor stretches the tick
+ *         I2C1 needs nothing: its kernel clock is HSI16 at both levels
+ *         (stm32g0xx_hal_msp.c), so the TIMINGR value never changes.
+ *
+ *         The prescalers are buffered: TIM_EGR_UG loads them at once.
+ *
+ */
+static void sysClockRescale(void) {
+	uint32_t count, load;
+
+	htimHandle->Instance->PSC = (SystemCoreClock / SYSCLK_SERVO_TIMER_HZ) - 1;
+	htimHandle->Instance->EGR = TIM_EGR_UG;
+
+	if (COIL_TIMER->CR1 & TIM_CR1_CEN) {
+		COIL_TIMER->PSC = (SystemCoreClock / COIL_TIMER_HZ) - 1;
+		COIL_TIMER->EGR = TIM_EGR_UG;
+	}
+
+	if (STATS_TIMER->CR1 & TIM_CR1_CEN) {
+		count = STATS_TIMER->CNT;
+		STATS_TIMER->PSC = (SystemCoreClock / STATS_TIMER_HZ) - 1;
+		STATS_TIMER->EGR = TIM_EGR_UG;
+		STATS_TIMER->CNT = count;
+	}
+
+	if (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) {
+		load = (SystemCoreClock / configTICK_RATE_HZ) - 1;
+		taskENTER_CRITICAL();
+		// Remaining count in new clock cycles; at most 64000 x 64000, fits 32 bits
+		count = (SysTick->VAL * (load + 1)) / (SysTick->LOAD + 1);
+		if (count < SYSCLK_TICK_MIN_REMAIN) {
+			count = SYSCLK_TICK_MIN_REMAIN;
+		}
+		SysTick->LOAD = count;
+		SysTick->VAL = 0;						// Reloads the remaining count on the next clock
+		while (SysTick->VAL == 0) {
+		}
+		SysTick->LOAD = load;					// Full period from the next wrap on
+		taskEXIT_CRITICAL();
+	}
+}
+
+
+/**
+ * @brief  Switch SYSCLK between HSI16 and the PLL.
+ *
+ *         Fast: the PLL (HSI16 x8 /2 = 64 MHz, same as SystemClock_Config)
+ *         is started and locked first, then selected. Idle: HSI16 is
+ *         selected first, then the PLL is stopped to save its current.
+ *         HAL_RCC_ClockConfig() orders the Flash latency change around the
+ *         switch (raised before going fast, lowered after going idle).
+ *
+ *         On a HAL failure the clock stays where it is; the rescale always
+ *         follows SystemCoreClock, so the timers match the actual clock.
+ *
+ * @param  fast  1 = PLL 64 MHz, 0 = HSI16
+ */
+static void sysClockApply(uint8_t fast) {
+	RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+	RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1;
+	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+
+	if (fast) {
+		RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+		RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+		RCC_OscInitStruct.PLL.PLLM = RCC_PLLM_DIV1;
+		RCC_OscInitStruct.PLL.PLLN = 8;
+		RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
+		RCC_OscInitStruct.PLL.PLLQ = RCC_PLLQ_DIV2;
+		RCC_OscInitStruct.PLL.PLLR = RCC_PLLR_DIV2;
+		if (HAL_RCC_OscConfig(&RCC_OscInitStruct) == HAL_OK) {
+			RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+			HAL_RCC_ClockConfig(&RCC_ClkInitStruct, SYSCLK_FAST_LATENCY);
+		}
+	} else {
+		RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+		if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, SYSCLK_IDLE_LATENCY) == HAL_OK) {
+			RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+			HAL_RCC_OscConfig(&RCC_OscInitStruct);
+		}
+	}
+
+	sysClockRescale();
+	sysStats.clockSwitches++;
+}
+
+
+/**
+ * @brief  Drop to the idle clock.
+ *
+ *         Called from createRTOS_Tasks() after the peripherals are set up
+ *         at 64 MHz and before the scheduler starts, so vTaskStartScheduler()
+ *         programs SysTick and TIM2 from the idle SystemCoreClock.
+ *
+ */
+void sysClockInit(void) {
+	sysClockUsers = 0;
+	sysClockApply(0);
+}
+
+
+/**
+ * @brief  Hold the fast clock for a user.
+ *
+ *         The first holder starts the PLL; later holders only add their bit.
+ *         vTaskSuspendAll(): keeps the other task from changing the level
+ *         halfway; the interrupts stay enabled, so the HAL time base keeps
+ *         running for the PLL lock timeout.
+ *
+ * @param  user  Clock user (sysClockUserEnum)
+ */
+void sysClockBoost(uint8_t user) {
+	vTaskSuspendAll();
+	if (sysClockUsers == 0) {
+		sysClockApply(1);
+	}
+	sysClockUsers |= user;
+	xTaskResumeAll();
+}
+
+
+/**
+ * @brief  Release the fast clock for a user.
+ *
+ *         The last holder drops back to HSI16. Releasing a clock that is
+ *         not held is a no-op, so a release can be placed on every exit path.
+ *
+ * @param  user  Clock user (sysClockUserEnum)
+ */
+void sysClockRelease(uint8_t user) {
+	vTaskSuspendAll();
+	if (sysClockUsers & user) {
+		sysClockUsers &= ~user;
+		if (sysClockUsers == 0) {
+			sysClockApply(0);
+		}
+	}
+	xTaskResumeAll();
+}
+
+
+/**
+ * @brief  Restore the current level after a wake from STOP.
+ *
+ *         The core always resumes on HSI16 with the PLL off. Called by
+ *         powerSilentSleep() with the scheduler still suspended and the
+ *         ticks already restarted.
+ *
+ */
+void sysClockResume(void) {
+	sysClockApply(sysClockUsers != 0);
+}
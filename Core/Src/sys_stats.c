@@ -0,0 +1,153 @@
+/**
+ * @file   sys_stats.c
+ * @brief  Run time statistics: per-task CPU load, context switches and
+ *         display bus occupancy.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include "rtos_init.h"
+#include "sys_stats.h"
+#include "ssd1306.h"
+
+
+/*
+ *  Global variable definitions (declared extern in sys_stats.h and FreeRTOSConfig.h)
+ */
+sysStats_t sysStats;
+volatile uint32_t statsContextSwitches;
+
+// Counter values at the start of the current window
+static uint32_t prevWindowStart;
+static uint32_t prevRunTime[STATS_TASK_MAX];
+static uint32_t prevCtxSwitches;
+static uint32_t prevI2cBusy;
+static TickType_t prevUptimeTick;
+static uint32_t uptimeMs;
+
+
+/**
+ * @brief  Start the free-running run time statistics counter (TIM2).
+ *
+ *         Called by the kernel from vTaskStartScheduler() through the
+ *         portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() macro. TIM2 is the only
+ *         32-bit timer of the STM32G031: clocked at STATS_TIMER_HZ (1 MHz)
+ *         it wraps every ~71 minutes, and all the consumers work on unsigned
+ *         differences, so the wrap is harmless as long as a window is shorter.
+ *
+ *         The timer is programmed at register level: it has no interrupt and
+ *         no output, so a HAL handle would only cost RAM.
+ *
+ */
+void statsInitTimer(void) {
+	__HAL_RCC_TIM2_CLK_ENABLE();
+	STATS_TIMER->CR1 = 0;
+	STATS_TIMER->PSC = (SystemCoreClock / STATS_TIMER_HZ) - 1;
+	STATS_TIMER->ARR = 0xFFFFFFFFU;
+	STATS_TIMER->EGR = TIM_EGR_UG;		// Load the prescaler now
+	STATS_TIMER->CR1 = TIM_CR1_CEN;
+	prevWindowStart = STATS_TIMER->CNT;
+}
+
+
+/**
+ * @brief  Read the run time statistics counter.
+ *
+ *         Called by the kernel on every context switch through the
+ *         portGET_RUN_TIME_COUNTER_VALUE() macro, and used by the
+ *         application as a microsecond timestamp.
+ *
+ * @return Current counter value in us (wraps at 2^32)
+ */
+uint32_t statsGetCounter(void) {
+	return STATS_TIMER->CNT;
+}
+
+
+/**
+ * @brief  Close the current statistics window and refresh sysStats.
+ *
+ *         Called periodically by displayTask (every STATS_UPDATE_INTERVAL).
+ *         For each task computes the run time accumulated since the previous
+ *         call and converts it into a percentage of the window length. The
+ *         same is done for context switches and display bus busy time.
+ *
+ *         ulTaskGetRunTimeCounter(handle): returns the total time the task
+ *         has been in the Running state, in run time counter units (us).
+ *         ulTaskGetIdleRunTimeCounter() does the same for the idle task.
+ *
+ *         The percentages avoid 64-bit arithmetic: the window is divided by
+ *         100 first, so the result only loses sub-percent precision.
+ *
+ */
+void statsUpdate(void) {
+	TaskHandle_t handles[STATS_TASK_MAX] = {displayTaskHandle, buttonTaskHandle, clockTaskHandle, NULL};
+	uint32_t now = statsGetCounter();
+	uint32_t window = now - prevWindowStart;
+	uint32_t scale = window / 100;
+	uint32_t runTime, delta;
+	const ssd1306Stats_t *busStats = ssd1306_GetStats();
+
+	if (scale == 0) {
+		return;  // Window too short to be meaningful
+	}
+	prevWindowStart = now;
+	sysStats.windowTime = window;
+
+	for (uint8_t i = 0; i < STATS_TASK_MAX; i++) {
+		if (i == STATS_TASK_IDLE) {
+			runTime = ulTaskGetIdleRunTimeCounter();
+		} else {
+			runTime = ulTaskGetRunTimeCounter(handles[i]);
+		}
+		delta = runTime - prevRunTime[i];
+		prevRunTime[i] = runTime;
+		delta /= scale;
+		sysStats.cpuLoad[i] = (uint8_t)((delta > 100) ? 100 : delta);
+	}
+
+	sysStats.ctxSwitchesTotal = statsContextSwitches;
+	sysStats.ctxSwitches = sysStats.ctxSwitchesTotal - prevCtxSwitches;
+	prevCtxSwitches = sysStats.ctxSwitchesTotal;
+
+	sysStats.i2cBusyTime = busStats->busyTime - prevI2cBusy;
+	prevI2cBusy = busStats->busyTime;
+	delta = sysStats.i2cBusyTime / scale;
+	sysStats.i2cLoad = (uint8_t)((delta > 100) ? 100 : delta);
+	sysStats.i2cTransactions = busStats->transactions;
+	sysStats.i2cBytes = busStats->bytes;
+	sysStats.i2cErrors = busStats->errors;
+	sysStats.i2cFailures = busStats->failures;
+	sysStats.displayReinits = busStats->reinits;
+
+	// Uptime from the tick count (survives the 49-day tick wrap)
+	TickType_t tick = xTaskGetTickCount();
+	uptimeMs += (uint32_t)(tick - prevUptimeTick) * portTICK_PERIOD_MS;
+	prevUptimeTick = tick;
+	while (uptimeMs >= 1000) {
+		uptimeMs -= 1000;
+		sysStats.uptime++;
+	}
+}
+
+
+/**
+ * @brief  Record the duration of a display render, keeping the worst case.
+ *
+ *         Called by displayTask at the end of each render with the counter
+ *         value taken at its start (statsGetCounter()).
+ *
+ * @param  start  Run time counter value at the start of the render
+ */
+void statsRenderTime(uint32_t start) {
+	uint32_t elapsed = statsGetCounter() - start;
+	if (elapsed > sysStats.renderTimeMax) {
+		sysStats.renderTimeMax = elapsed;
+	}
+}
@@ -0,0 +1,183 @@
+/**
+ * @file   time_service.c
+ * @brief  Shared RTC time snapshot, published once per second and read
+ *         lock-free by every task.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include "rtos_init.h"
+#include "rtc_helpers.h"
+#include "time_service.h"
+
+
+// Snapshot and its sequence counter (odd while an update is in progress)
+static timeSnapshot_t timeSnap;
+static volatile uint32_t timeSeq;
+
+
+/**
+ * @brief  Read the RTC and publish a new snapshot (writer side).
+ *
+ *         Seqlock writer: the sequence goes odd, the fields are written,
+ *         the sequence goes even again. There is a single writer at a time:
+ *         the RTC alarm interrupt, or a task inside a critical section
+ *         (timeServicePublish), so the writer never has to wait.
+ *
+ *         The digits and the silent flag are computed here once, instead
+ *         of by every consumer on every poll.
+ *
+ *         The RTC is read in RTC_FORMAT_BCD, its native format: the display
+ *         digits are the two nibbles of each field and the binary values
+ *         need one multiply (bcdToBin), so no division runs here.
+ *
+ *         HAL_RTC_GetTime() MUST be followed by HAL_RTC_GetDate(): the
+ *         date read unlocks the time shadow registers.
+ *
+ */
+static void timeServiceUpdate(void) {
+	RTC_TimeTypeDef rtcTime;
+	RTC_DateTypeDef rtcDate;
+
+	HAL_RTC_GetTime(hrtcHandle, &rtcTime, RTC_FORMAT_BCD);
+	HAL_RTC_GetDate(hrtcHandle, &rtcDate, RTC_FORMAT_BCD);
+	uint8_t hours = bcdToBin(rtcTime.Hours);
+	uint8_t minutes = bcdToBin(rtcTime.Minutes);
+
+	timeSeq++;
+	__DMB();
+	timeSnap.hours = hours;
+	timeSnap.minutes = minutes;
+	timeSnap.seconds = bcdToBin(rtcTime.Seconds);
+	timeSnap.weekDay = rtcDate.WeekDay;
+	timeSnap.digits[0] = rtcTime.Hours >> 4;
+	timeSnap.digits[1] = rtcTime.Hours & 0x0F;
+	timeSnap.digits[2] = rtcTime.Minutes >> 4;
+	timeSnap.digits[3] = rtcTime.Minutes & 0x0F;
+	timeSnap.silent = isSilentAt(rtcDate.WeekDay, hours, minutes);
+	__DMB();
+	timeSeq++;
+}
+
+
+/**
+ * @brief  Start the 1 Hz RTC alarm.
+ *
+ *         Alarm A with every field masked (date, hours, minutes, seconds
+ *         and sub-seconds) fires on each second increment.
+ *
+ *         HAL_RTC_SetAlarm_IT(): programs the alarm and enables its EXTI
+ *         line and interrupt in the RTC.
+ *
+ */
+static void timeServiceStartAlarm(void) {
+	RTC_AlarmTypeDef alarm = {0};
+
+	alarm.Alarm = RTC_ALARM_A;
+	alarm.AlarmMask = RTC_ALARMMASK_ALL;
+	alarm.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_ALL;
+	alarm.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_DATE;
+	alarm.AlarmDateWeekDay = 1;
+	if (HAL_RTC_SetAlarm_IT(hrtcHandle, &alarm, RTC_FORMAT_BCD) != HAL_OK) {
+		Error_Handler();
+	}
+}
+
+
+/**
+ * @brief  Publish the first snapshot and start the 1 Hz RTC alarm.
+ *
+ *         Called from createRTOS_Tasks() before the scheduler starts.
+ *         The alarm shares the RTC_TAMP interrupt with alarm B (power_mgr);
+ *         its handler is in stm32g0xx_it.c.
+ *
+ */
+void timeServiceInit(void) {
+	timeServiceUpdate();
+	timeServiceStartAlarm();
+
+	HAL_NVIC_SetPriority(RTC_TAMP_IRQn, TIME_ALARM_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(RTC_TAMP_IRQn);
+}
+
+
+/**
+ * @brief  Publish a snapshot now (task context).
+ *
+ *         Called after the RTC was set, so consumers see the new time
+ *         without waiting for the next alarm. The critical section keeps
+ *         the alarm interrupt from becoming a second writer.
+ *
+ */
+void timeServicePublish(void) {
+	taskENTER_CRITICAL();
+	timeServiceUpdate();
+	taskEXIT_CRITICAL();
+}
+
+
+/**
+ * @brief  RTC alarm A callback (interrupt context, once per second).
+ *
+ *         Called from HAL_RTC_AlarmAEventCallback (main.c).
+ *
+ */
+void timeServiceAlarmCallback(void) {
+	timeServiceUpdate();
+}
+
+
+/**
+ * @brief  Stop the 1 Hz alarm (the MCU is going to STOP).
+ *
+ *         Called by powerSilentSleep() with the scheduler suspended: nobody
+ *         reads the time while the alarm is off.
+ *
+ */
+void timeServiceSuspend(void) {
+	HAL_RTC_DeactivateAlarm(hrtcHandle, RTC_ALARM_A);
+}
+
+
+/**
+ * @brief  Restart the 1 Hz alarm and publish the time after a wake.
+ *
+ *         The snapshot is stale by the whole sleep, so it is refreshed now
+ *         instead of at the next second.
+ *
+ */
+void timeServiceResume(void) {
+	timeServiceStartAlarm();
+	timeServicePublish();
+}
+
+
+/**
+ * @brief  Copy the current time snapshot (reader side, lock-free).
+ *
+ *         Seqlock reader: copy the fields and retry if the sequence was odd
+ *         or changed meanwhile, i.e. the alarm interrupt published a new
+ *         snapshot during the copy. Readers never block the writer and the
+ *         retry is at most once per second.
+ *
+ * @param[out] snap  Consistent copy of the published time
+ * @return Sequence number of the copy (changes on every publish)
+ */
+uint32_t timeGetSnapshot(timeSnapshot_t *snap) {
+	uint32_t seq;
+
+	do {
+		seq = timeSeq;
+		__DMB();
+		*snap = timeSnap;
+		__DMB();
+	} while ((seq & 1) || (seq != timeSeq));
+
+	return seq;
+}
@@ -1,6 +1,6 @@
 /**
  * @file   ssd1306.h
- * @brief  SSD1306 OLED display driver over I2C with scalable font rendering.
+ * @brief  SSD1306 OLED display driver with scalable font rendering.
  *
  * @version 2.0
  * @date    12/02/2026
@@ -21,31 +21,85 @@
 #ifndef _SSD1306_H_
 #define _SSD1306_H_
 
-#include "main.h"
-
-// I2C parameters
-#define SSD1306_I2C_ADDR        0x3C << 1 // Alternate address 0x3D - When shifted 0x78 and 0x7A
-#define SSD1306_I2C_TIMEOUT     10
-#define SSD1306_I2C_CMD         0x00
-#define SSD1306_I2C_DATA        0x40
+#include "ssd1306_transport.h"  // Bus backend (I2C, I2C DMA, SPI or host recorder) and its parameters
 
 // Display dimensions
 #define SSD1306_WIDTH           128
 #define SSD1306_HEIGHT          64
+#define SSD1306_PAGES           (SSD1306_HEIGHT / 8)
+
+// Command/data buffer (largest data chunk of a blit, holds the init string)
+#define SSD1306_BUFF_SIZE		32
 
 // Display flip Screen
 #define SSD1306_INIT_LEN		20 // 18: no screen flip, 20: screen flip
 
+// Optional RAM band (-DSSD1306_BAND_BUFFER=ON): pages composed in RAM, changed columns sent as one burst
+// Pages 2-7 hold the clock digits (pages 4-7) and the digit cursor (pages 2-3): 768 bytes of .bss
+#ifdef SSD1306_BAND_BUFFER
+#define SSD1306_BAND_FIRST		2
+#define SSD1306_BAND_PAGES		6
+#define SSD1306_BAND_SIZE		(SSD1306_WIDTH * SSD1306_BAND_PAGES)
+#endif
+
 // Single character  width
 #define SSD1306_CHAR_WIDTH		6
 
+// Bus statistics time base (free-running us counter, see STATS_TIMER in main.h)
+#ifdef STATS_TIMER
+#define SSD1306_TIMESTAMP()		(STATS_TIMER->CNT)
+#else
+#define SSD1306_TIMESTAMP()		0
+#endif
+
+// Bus statistics (cumulative since init, counters wrap)
+typedef struct {
+	uint32_t transactions;		// Number of bus writes
+	uint32_t bytes;				// Payload bytes written (control byte excluded)
+	uint32_t busyTime;			// Time spent inside the bus writes in us (DMA: waiting for the previous one)
+	uint32_t errors;			// Failed attempts (each followed by a bus recovery and a retry)
+	uint32_t failures;			// Writes given up after SSD1306_BUS_RETRIES (driver offline)
+	uint32_t dropped;			// Writes skipped while offline
+	uint32_t reinits;			// Panel re-initializations by ssd1306_Recover
+} ssd1306Stats_t;
+
+// Blit column generator: fill out[0..pages-1] for column (0 = left edge of the window)
+typedef void (*ssd1306Gen_t)(uint8_t column, uint8_t pages, uint8_t *out, void *arg);
+
+// ssd1306_GenText argument
+typedef struct {
+	const char *text;			// NUL terminated
+	uint8_t fsize;				// Font size as ssd1306_WriteChar
+	uint8_t offset;				// Blank columns before the first character
+} ssd1306Text_t;
+
+// ssd1306_GenPattern argument
+typedef struct {
+	const uint8_t *data;		// One byte per column
+	uint8_t length;				// Columns before the pattern repeats
+} ssd1306Pattern_t;
+
 //  Function declaration
-void ssd1306_Init(I2C_HandleTypeDef *hi2c);			// Init function pass the pointer to the I2C handle structure
+void ssd1306_Init(ssd1306Bus_t *bus);				// Init function pass the pointer to the bus handle structure
 void ssd1306_ClearScreen(void);						// Clear Screen
 void ssd1306_WriteChar(char ch, uint8_t fsize);		// Font size 0: 5x8, 1: 10x16, 2: 15x24 3: 20x32
 void ssd1306_WriteString(char *msg, uint8_t fsize);	// Font size 0: 5x8, 1: 10x16, 2: 15x24 3: 20x32
-void ssd1306_SetCursor(uint8_t xpos, uint8_t ypos); // Vertical value is with increments of 8 pixels
+void ssd1306_SetCursor(uint8_t xpos, uint8_t ypos); // Vertical value is with increments of 8 pixels (no bus traffic)
+void ssd1306_Blit(uint8_t xpos, uint8_t ypos, uint8_t width, uint8_t pages, ssd1306Gen_t gen, void *arg); // One window, columns from gen
+void ssd1306_GlyphColumn(char ch, uint8_t fsize, uint8_t column, uint8_t pages, uint8_t *out); // One column of a magnified character
+void ssd1306_GenFill(uint8_t column, uint8_t pages, uint8_t *out, void *arg);		// arg: const uint8_t * fill byte
+void ssd1306_GenPattern(uint8_t column, uint8_t pages, uint8_t *out, void *arg);	// arg: ssd1306Pattern_t *
+void ssd1306_GenText(uint8_t column, uint8_t pages, uint8_t *out, void *arg);		// arg: ssd1306Text_t *
 void ssd1306_SetContrast(uint8_t contrast);			// Set the display contrast 0 - 255
 void ssd1306_SetDisplayOnOff(uint8_t onOff); 		// 1 = Display on, 0 = Display off
+void ssd1306_Sleep(void);							// Display off and charge pump off (RAM and settings kept)
+void ssd1306_Wake(uint8_t contrast);				// Charge pump on, contrast, display on (one transaction)
+const ssd1306Stats_t *ssd1306_GetStats(void);		// Bus statistics
+uint8_t ssd1306_Recover(void);						// After bus faults: re-init and blank the panel, 1 = redraw needed
+
+#ifdef SSD1306_BAND_BUFFER
+void ssd1306_BandBlit(uint8_t xpos, uint8_t ypos, uint8_t width, uint8_t pages, ssd1306Gen_t gen, void *arg); // As ssd1306_Blit, into the RAM band
+void ssd1306_BandFlush(void);						// Send the changed columns as one window and one burst
+#endif
 
 #endif  // _SSD1306_H_
@@ -0,0 +1,74 @@
+/**
+ * @file   ssd1306_emu.h
+ * @brief  Host SSD1306 emulator: decodes the driver's command/data stream into a framebuffer.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef _SSD1306_EMU_H_
+#define _SSD1306_EMU_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// Host only: fed by the recorder transport (SSD1306_TRANSPORT_HOST), either live
+// through ssd1306_HostSetSink or afterwards from the recorded log.
+#if (SSD1306_TRANSPORT != SSD1306_TRANSPORT_HOST)
+#error "ssd1306_emu needs SSD1306_TRANSPORT_HOST"
+#endif
+
+// Controller memory (GDDRAM): 8 pages of 128 columns, one byte = 8 vertical pixels
+#define SSD1306_EMU_PAGES		8
+#define SSD1306_EMU_COLUMNS		128
+
+// Memory addressing modes (command 0x20)
+enum ssd1306EmuAddrEnum{
+	SSD1306_EMU_HORIZONTAL = 0,
+	SSD1306_EMU_VERTICAL = 1,
+	SSD1306_EMU_PAGE = 2,
+};
+
+// Traffic of one frame (between two ssd1306_EmuFrameEnd calls)
+typedef struct {
+	uint32_t transactions;		// Bus writes
+	uint32_t cmdBytes;			// Command bytes (control byte excluded)
+	uint32_t dataBytes;			// GDDRAM bytes
+} ssd1306EmuTraffic_t;
+
+// Emulated controller state
+typedef struct {
+	uint8_t ram[SSD1306_EMU_PAGES][SSD1306_EMU_COLUMNS];
+	uint8_t addrMode;			// ssd1306EmuAddrEnum
+	uint8_t col, page;			// Write pointer
+	uint8_t colStart, colEnd;	// Window (0x21)
+	uint8_t pageStart, pageEnd;	// Window (0x22)
+	uint8_t displayOn;			// 0xAE / 0xAF
+	uint8_t chargePump;			// 0x8D 0x14 / 0x10
+	uint8_t contrast;			// 0x81
+	uint8_t segRemap;			// 0xA0 / 0xA1
+	uint8_t comRemap;			// 0xC0 / 0xC8
+	uint32_t unknown;			// Command bytes not decoded
+	ssd1306EmuTraffic_t frame;	// Current frame
+	ssd1306EmuTraffic_t last;	// Last closed frame
+	ssd1306EmuTraffic_t total;	// Since ssd1306_EmuInit
+	uint32_t frames;			// Closed frames
+} ssd1306Emu_t;
+
+//  Function declaration
+void ssd1306_EmuInit(void);												// Power-on reset state, counters cleared
+void ssd1306_EmuAttach(void);											// Decode every transfer live (host recorder sink)
+void ssd1306_EmuFeed(uint8_t mode, const uint8_t *data, uint16_t length);	// Decode one transfer
+void ssd1306_EmuReplay(const ssd1306HostLog_t *log);					// Decode a recorded log
+const ssd1306EmuTraffic_t *ssd1306_EmuFrameEnd(void);					// Close the frame, return its traffic
+const ssd1306Emu_t *ssd1306_EmuGetState(void);							// Framebuffer and controller state
+uint8_t ssd1306_EmuGetPixel(uint8_t x, uint8_t y);						// 1 = lit (GDDRAM coordinates)
+int ssd1306_EmuWritePbm(const char *path);								// Framebuffer as binary PBM (P4), 0 = OK
+
+#endif  // _SSD1306_EMU_H_
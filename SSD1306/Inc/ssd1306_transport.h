@@ -0,0 +1,116 @@
+/**
+ * @file   ssd1306_transport.h
+ * @brief  SSD1306 bus transport interface, one backend selected at build time.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef _SSD1306_TRANSPORT_H_
+#define _SSD1306_TRANSPORT_H_
+
+// Transport backends (SSD1306/CMakeLists.txt: -DSSD1306_TRANSPORT=<name>)
+// Exactly one backend source is compiled, so the driver calls it directly:
+// no function pointer, no runtime switch.
+#define SSD1306_TRANSPORT_I2C		0	// Blocking HAL_I2C_Mem_Write (ssd1306_i2c.c)
+#define SSD1306_TRANSPORT_I2C_DMA	1	// HAL_I2C_Mem_Write_DMA, returns while the bus runs (ssd1306_i2c_dma.c)
+#define SSD1306_TRANSPORT_SPI		2	// 4-wire SPI with D/C and CS pins (ssd1306_spi.c)
+#define SSD1306_TRANSPORT_HOST		3	// Host recorder, no hardware (ssd1306_host.c)
+
+#ifndef SSD1306_TRANSPORT
+#define SSD1306_TRANSPORT			SSD1306_TRANSPORT_I2C
+#endif
+
+#if (SSD1306_TRANSPORT == SSD1306_TRANSPORT_HOST)
+#include <stdint.h>
+#else
+#include "main.h"
+#endif
+
+// Bus handle passed to ssd1306_Init
+#if (SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI)
+#ifndef HAL_SPI_MODULE_ENABLED
+#error "SSD1306_TRANSPORT_SPI needs the HAL SPI module (enable SPI in CubeMX)"
+#endif
+typedef SPI_HandleTypeDef ssd1306Bus_t;
+#elif (SSD1306_TRANSPORT == SSD1306_TRANSPORT_HOST)
+typedef void ssd1306Bus_t;
+#else
+typedef I2C_HandleTypeDef ssd1306Bus_t;
+#endif
+
+// Control byte of each transfer (I2C control byte, D/C pin level on SPI)
+#define SSD1306_I2C_CMD         0x00
+#define SSD1306_I2C_DATA        0x40
+
+// Bus parameters
+#define SSD1306_I2C_ADDR        0x3C << 1 // Alternate address 0x3D - When shifted 0x78 and 0x7A
+#define SSD1306_I2C_TIMEOUT     10
+#define SSD1306_DMA_BUFF_SIZE	32		// DMA backend copy of the caller's buffer (longer writes are split)
+
+// I2C speed in kHz: 100 (CubeMX setting), 400 or 1000 (Fast-mode Plus, needs strong pull-ups)
+// TIMINGR values for the 16 MHz HSI16 kernel clock (RM0444 timing examples), set by ssd1306_I2cConfigure
+#ifndef SSD1306_I2C_SPEED
+#define SSD1306_I2C_SPEED		100
+#endif
+#if (SSD1306_I2C_SPEED == 1000)
+#define SSD1306_I2C_TIMING		0x00200204
+#define SSD1306_I2C_BYTE_SHIFT	6		// >= 64 bytes/ms
+#elif (SSD1306_I2C_SPEED == 400)
+#define SSD1306_I2C_TIMING		0x10320309
+#define SSD1306_I2C_BYTE_SHIFT	5		// >= 32 bytes/ms
+#else
+#define SSD1306_I2C_TIMING		0x00503D58
+#define SSD1306_I2C_BYTE_SHIFT	3		// >= 8 bytes/ms
+#endif
+#define SSD1306_BUS_TIMEOUT(len)	(SSD1306_I2C_TIMEOUT + ((len) >> SSD1306_I2C_BYTE_SHIFT))	// ms
+
+// Bus fault handling: a failed transfer is retried after a bus recovery
+// (I2C: SCL clocked to free SDA, STOP, I2C1 re-initialized), then given up
+#define SSD1306_BUS_RETRIES		2
+#define SSD1306_BUS_GAVE_UP(failed)	((failed) > SSD1306_BUS_RETRIES)
+
+// I2C1 pins (as in HAL_I2C_MspInit), driven as GPIO during a bus recovery
+#define SSD1306_I2C_GPIO_Port	GPIOB
+#define SSD1306_I2C_SDA_Pin		GPIO_PIN_7
+#define SSD1306_I2C_SCL_Pin		GPIO_PIN_8
+#define SSD1306_I2C_FMP			(I2C_FASTMODEPLUS_PB7 | I2C_FASTMODEPLUS_PB8)
+
+// Host recorder log (SSD1306_TRANSPORT_HOST only)
+#define SSD1306_HOST_LOG_SIZE	8192	// Bytes: [control][length low][length high][payload] per transfer
+
+typedef struct {
+	uint32_t transactions;					// Transfers since the last reset
+	uint32_t bytes;							// Payload bytes since the last reset
+	uint32_t length;						// Bytes used in stream[]
+	uint32_t overflow;						// Transfers that did not fit in stream[]
+	uint8_t stream[SSD1306_HOST_LOG_SIZE];
+} ssd1306HostLog_t;
+
+typedef void (*ssd1306HostSink_t)(uint8_t mode, const uint8_t *data, uint16_t length);
+
+//  Function declaration (implemented by the selected backend)
+//  Write, Burst and Flush return the failed attempts (0 = clean, SSD1306_BUS_GAVE_UP = lost)
+void ssd1306_TransportInit(ssd1306Bus_t *bus);
+uint8_t ssd1306_TransportWrite(uint8_t mode, const uint8_t *data, uint16_t length);
+uint8_t ssd1306_TransportBurst(uint8_t mode, const uint8_t *data, uint16_t length);	// One transfer, data untouched until the next flush
+uint8_t ssd1306_TransportFlush(void);				// Wait until the last transfer is on the wire
+
+#if (SSD1306_TRANSPORT == SSD1306_TRANSPORT_I2C) || (SSD1306_TRANSPORT == SSD1306_TRANSPORT_I2C_DMA)
+void ssd1306_I2cConfigure(I2C_HandleTypeDef *hi2c);	// Timing (SSD1306_I2C_SPEED) and Fast-mode Plus drive
+void ssd1306_I2cRecover(I2C_HandleTypeDef *hi2c);	// Free a stuck bus and re-initialize I2C1
+#endif
+
+#if (SSD1306_TRANSPORT == SSD1306_TRANSPORT_HOST)
+void ssd1306_HostReset(void);						// Clear the log and the counters
+const ssd1306HostLog_t *ssd1306_HostGetLog(void);	// Recorded transfers
+void ssd1306_HostSetSink(ssd1306HostSink_t sink);	// Also forward every transfer (e.g. to an emulator)
+void ssd1306_HostFail(uint8_t count);				// Make the next count write attempts fail (fault injection)
+#endif
+
+#endif  // _SSD1306_TRANSPORT_H_
@@ -1,6 +1,6 @@
 /**
  * @file   ssd1306.c
- * @brief  SSD1306 OLED display driver over I2C with scalable font rendering.
+ * @brief  SSD1306 OLED display driver with scalable font rendering.
  *
  * @version 2.0
  * @date    12/02/2026
@@ -96,9 +96,8 @@ const uint8_t font_5x8[] = {
 // Cursor variables
 static uint8_t col, page;
 
-// I2C variables
-static I2C_HandleTypeDef *i2cHandle = NULL;
-static uint8_t i2cBuff[24] = {
+// Initialization string (also re-sent by ssd1306_Recover)
+static const uint8_t initCmd[] = {
 #if (SSD1306_HEIGHT == 64)
 		0xA8, 0x3F, 		// Set multiplex (HEIGHT-1): 0x3F for 128x64
 		0x22, 0x00, 0x07, 	// Set min and max page:  0x07 for 128x64
@@ -108,111 +107,248 @@ static uint8_t i2cBuff[24] = {
 		0x22, 0x00, 0x03,	// Set min and max page:  0x03 for 128x32
 		0xDA, 0x02,			// Set COM pins hardware config to seq: 0x02 for 128x32
 #endif
-		0x20, 0x00,			// Set horizontal memory addressing mode
+		0x20, 0x01,			// Set vertical memory addressing mode (ssd1306_Blit streams columns)
 		0x8D, 0x14,			// Enable charge pump
 		0x81, 0xFF,			// Set contrast 0x01 = Min contrast, 0xFF = Max contrast
 		0xD5, 0xF0,			// Set display clock divide and frequency set clock to max
 		0x2E,				// Deactivate scroll
 		0xD3, 0x00,			// Set display offset to 0
 		0xA1, 0xC8,			// Flip the screen
-		0x00, 0x00,			// Dummy bytes
-		0x00, 0x00,			// Dummy bytes
 		};
 
+// Command/data buffer
+static uint8_t i2cBuff[SSD1306_BUFF_SIZE];
 
-//  IC2 Write Function
-static void i2cWrite(uint8_t mode, uint8_t *data, uint8_t lenght){
-	if (HAL_I2C_Mem_Write(i2cHandle, SSD1306_I2C_ADDR, mode, 1, data, lenght, SSD1306_I2C_TIMEOUT) != HAL_OK) {
-		Error_Handler();
+// Bus statistics
+static ssd1306Stats_t busStats;
+
+// Bus fault state: a write failed (the panel may have lost its setup) / a write was given up (offline)
+static uint8_t busReinit, busFault;
+
+#ifdef SSD1306_BAND_BUFFER
+// RAM band, column-major (vertical addressing order): column c, page p at [c * SSD1306_BAND_PAGES + p]
+static uint8_t band[SSD1306_BAND_SIZE];
+static uint8_t bandFirst = SSD1306_WIDTH, bandLast;	// Changed columns since the last flush (none: first > last)
+#endif
+
+
+//  Account for the failed attempts reported by the transport
+static void busStatus(uint8_t failed) {
+	if (failed) {
+		busStats.errors += failed;
+		busReinit = 1;
+		if (SSD1306_BUS_GAVE_UP(failed)) {
+			busStats.failures++;
+			busFault = 1;
+		}
+	}
+}
+
+
+//  Bus Write Function (the transport backend is chosen at build time, see ssd1306_transport.h)
+//  Offline (a write was given up): nothing is sent until ssd1306_Recover
+static void busWrite(uint8_t mode, const uint8_t *data, uint16_t length){
+	uint32_t start;
+
+	if (busFault) {
+		busStats.dropped++;
+		return;
 	}
+	start = SSD1306_TIMESTAMP();
+	busStatus(ssd1306_TransportWrite(mode, data, length));
+	busStats.busyTime += SSD1306_TIMESTAMP() - start;
+	busStats.transactions++;
+	busStats.bytes += length;
 }
 
 
 //  Initialize the display
-void ssd1306_Init(I2C_HandleTypeDef *hi2c) {
-	i2cHandle = hi2c;
+void ssd1306_Init(ssd1306Bus_t *bus) {
+	ssd1306_TransportInit(bus);
+	busReinit = 0;
+	busFault = 0;
 
 	// Send the initialization string
-	i2cWrite(SSD1306_I2C_CMD, i2cBuff, SSD1306_INIT_LEN);
+	busWrite(SSD1306_I2C_CMD, initCmd, SSD1306_INIT_LEN);
 
 	ssd1306_ClearScreen();
 	ssd1306_SetDisplayOnOff(1);
 }
 
 
-// Clear screen
+//  Bring the panel back after bus faults: back online, initialization string, blank screen, display on
+//  (a panel reset by the glitch has lost its setup and its RAM). Returns 1 when done: the caller
+//  restores contrast and display state and redraws everything. Nothing to do without a fault.
+uint8_t ssd1306_Recover(void) {
+	if (!busReinit) {
+		return 0;
+	}
+	busReinit = 0;
+	busFault = 0;
+	busStats.reinits++;
+
+	busWrite(SSD1306_I2C_CMD, initCmd, SSD1306_INIT_LEN);
+	ssd1306_ClearScreen();
+	ssd1306_SetDisplayOnOff(1);
+	return 1;
+}
+
+
+// Clear screen (and the RAM band, already blank on the panel)
 void ssd1306_ClearScreen(void) {
-	uint8_t i, blocks;
-	blocks = SSD1306_WIDTH * SSD1306_HEIGHT / 8 / 16;
-	ssd1306_SetCursor(0, 0);              // Set cursor at upper left corner
-	for (i = 0; i < 16; i++) {
-		i2cBuff[i] = 0x00;
+	const uint8_t blank = 0x00;
+	ssd1306_Blit(0, 0, SSD1306_WIDTH, SSD1306_PAGES, ssd1306_GenFill, (void *) &blank);
+#ifdef SSD1306_BAND_BUFFER
+	busStatus(ssd1306_TransportFlush());	// The last burst may still be reading the band
+	for (uint16_t i = 0; i < SSD1306_BAND_SIZE; i++) {
+		band[i] = 0x00;
+	}
+	bandFirst = SSD1306_WIDTH;
+	bandLast = 0;
+#endif
+}
+
+
+// Blit a window: one address window, then the columns streamed from the generator
+// Vertical addressing: each column fills its pages top to bottom, then the next column
+// The window is clipped to the screen; the data is sent in SSD1306_BUFF_SIZE chunks
+void ssd1306_Blit(uint8_t xpos, uint8_t ypos, uint8_t width, uint8_t pages, ssd1306Gen_t gen, void *arg) {
+	uint8_t n = 0;
+
+	xpos &= 0x7F;						// Prevent column overflow
+	ypos &= (SSD1306_PAGES - 1);		// Prevent rows overflow
+	if (width > (SSD1306_WIDTH - xpos)) {
+		width = SSD1306_WIDTH - xpos;
+	}
+	if (pages > (SSD1306_PAGES - ypos)) {
+		pages = SSD1306_PAGES - ypos;
 	}
-	for (i = 0; i < blocks; i++) {
-		i2cWrite(SSD1306_I2C_DATA, i2cBuff, 16);
+	if ((width == 0) || (pages == 0)) {
+		return;
 	}
+
+	i2cBuff[0] = 0x21;					// Set column window
+	i2cBuff[1] = xpos;
+	i2cBuff[2] = xpos + width - 1;
+	i2cBuff[3] = 0x22;					// Set page window
+	i2cBuff[4] = ypos;
+	i2cBuff[5] = ypos + pages - 1;
+	busWrite(SSD1306_I2C_CMD, i2cBuff, 6);
+
+	for (uint8_t c = 0; c < width; c++) {
+		if ((n + pages) > SSD1306_BUFF_SIZE) {
+			busWrite(SSD1306_I2C_DATA, i2cBuff, n);
+			n = 0;
+		}
+		gen(c, pages, &i2cBuff[n], arg);
+		n += pages;
+	}
+	busWrite(SSD1306_I2C_DATA, i2cBuff, n);
 }
 
 
-// Print a character
-void ssd1306_WriteChar(char ch, uint8_t fsize) {
-	uint8_t sliceChar, shifter;
-	uint16_t offsetChar; // calculated position of character in font array
-	uint32_t temp;
+// One column of a character, magnified by fsize, top page first
+// Columns 5 x scale to 6 x scale - 1 are the blank spacing
+void ssd1306_GlyphColumn(char ch, uint8_t fsize, uint8_t column, uint8_t pages, uint8_t *out) {
+	uint8_t scale = (fsize & 0x03) + 1;	// Prevent array overflow
+	uint8_t slice = 0;
+	uint8_t font;
+	uint32_t temp = 0;
 
-	fsize = (fsize & 0x03) + 1; // Prevent array overflow
 	if ((ch < 32) || (ch > 100)) {
-		ch = 32; 				// Prevent to search outside of chars array
+		ch = 32; 						// Prevent to search outside of chars array
+	}
+	while (column >= scale) {			// Font slice of the column (no divide on the M0+)
+		column -= scale;
+		slice++;
+	}
+	if (slice < 5) {
+		font = font_5x8[((ch - 32) * 5) + slice];
+		for (uint8_t j = 0; j < 8; j++) {	// Multiply the pixels in vertical based on size
+			if (font & (0x01 << j)) {
+				temp |= ((1UL << scale) - 1) << (j * scale);
+			}
+		}
+	}
+	for (uint8_t k = 0; k < pages; k++) {
+		out[k] = (uint8_t) temp;		// Portion of the column on each page
+		temp >>= 8;
 	}
+}
 
-	for (uint8_t k = 0; k < fsize; k++) {
-		offsetChar = (ch - 32) * 5;
-		for (sliceChar = 0; sliceChar < (5 * fsize); sliceChar += fsize) {
-			temp = 0;
 
-			for (uint8_t j = 0; j < 8; j++) { // This routine is designed to multiply the pixels in vertical based on size
-				shifter = j * (fsize - 1); // Set the shift amount to spread the pixels on multiple pages based on size
-				for (uint8_t m = 0; m < fsize; m++) {
-					temp |= ((font_5x8[offsetChar] & (0x01 << j)) << (shifter + m));
-				}
-			}
-			shifter = 8 * k; // Set the shifting amount to select the right portion of the char
-			for (uint8_t m = 0; m < fsize; m++) {
-				i2cBuff[sliceChar + m] = (uint8_t) (temp >> shifter);
-			}
-			offsetChar++;
+// Generator: every byte is the fill pattern (arg: const uint8_t *)
+void ssd1306_GenFill(uint8_t column, uint8_t pages, uint8_t *out, void *arg) {
+	(void) column;
+	for (uint8_t k = 0; k < pages; k++) {
+		out[k] = *(const uint8_t *) arg;
+	}
+}
+
+
+// Generator: repeat a sequence of columns (arg: ssd1306Pattern_t *, one page)
+void ssd1306_GenPattern(uint8_t column, uint8_t pages, uint8_t *out, void *arg) {
+	const ssd1306Pattern_t *pattern = arg;
+
+	while (column >= pattern->length) {
+		column -= pattern->length;
+	}
+	for (uint8_t k = 0; k < pages; k++) {
+		out[k] = pattern->data[column];
+	}
+}
+
+
+// Generator: a string in the magnified font (arg: ssd1306Text_t *)
+// Columns before offset and after the last character are blank
+void ssd1306_GenText(uint8_t column, uint8_t pages, uint8_t *out, void *arg) {
+	const ssd1306Text_t *text = arg;
+	const char *ch = text->text;
+	uint8_t width = ((text->fsize & 0x03) + 1) * SSD1306_CHAR_WIDTH;
+
+	if (column >= text->offset) {
+		column -= text->offset;
+		while ((*ch != 0) && (column >= width)) {
+			column -= width;
+			ch++;
 		}
-		for (uint8_t m = 0; m < fsize; m++) {
-			i2cBuff[sliceChar++] = 0x00;
+		if (*ch != 0) {
+			ssd1306_GlyphColumn(*ch, text->fsize, column, pages, out);
+			return;
 		}
-		i2cWrite(SSD1306_I2C_DATA, i2cBuff, sliceChar);
-		ssd1306_SetCursor(col, ++page);
 	}
-	ssd1306_SetCursor(col += (fsize * SSD1306_CHAR_WIDTH), page -= fsize);
+	for (uint8_t k = 0; k < pages; k++) {
+		out[k] = 0x00;
+	}
+}
+
 
+// Print a character: one window of 6 x scale columns, scale pages
+void ssd1306_WriteChar(char ch, uint8_t fsize) {
+	char msg[2] = {ch, 0};
+	ssd1306_WriteString(msg, fsize);
 }
 
-// Print a string
+// Print a string: one window for the whole string
 void ssd1306_WriteString(char *msg, uint8_t fsize) {
-	char ch = *msg;             	// Read first character from program memory
-	while (ch != 0) {				// Repeat until string terminator
-		ssd1306_WriteChar(ch, fsize); // Print character
-		ch = *(++msg);              // Read next character
+	ssd1306Text_t text = {msg, fsize, 0};
+	uint8_t scale = (fsize & 0x03) + 1;
+	uint16_t width = 0;
+
+	while (msg[width] != 0) {
+		width++;
 	}
+	width *= scale * SSD1306_CHAR_WIDTH;
+	ssd1306_Blit(col, page, (width > SSD1306_WIDTH) ? SSD1306_WIDTH : width, scale, ssd1306_GenText, &text);
+	col += (width > (SSD1306_WIDTH - col)) ? (SSD1306_WIDTH - col) : width;
+	col &= 0x7F;
 }
 
 // Set cursor position - Vertical value is with increments of 8 pixels
+// No bus traffic: the next write sends its own window
 void ssd1306_SetCursor(uint8_t xpos, uint8_t ypos) {
 	col = xpos & 0x7F;				//Prevent column overflow
-#if (SSD1306_HEIGHT == 64)
-	page = ypos & 0x07;				//Prevent rows overflow if 8 rows (64 pixel height)
-#else
-	page = ypos & 0x03;				//Prevent rows overflow if 4 rows (32 pixel height)
-#endif
-	i2cBuff[0] = col & 0x0F;		// set low nibble of start column
-	i2cBuff[1] = 0x10 | (col >> 4);	// set high nibble of start column
-	i2cBuff[2] = 0xB0 | page;		// set start page
-	i2cWrite(SSD1306_I2C_CMD, i2cBuff, 3);
+	page = ypos & (SSD1306_PAGES - 1);	//Prevent rows overflow
 }
 
 
@@ -220,12 +356,116 @@ void ssd1306_SetCursor(uint8_t xpos, uint8_t ypos) {
 void ssd1306_SetContrast(uint8_t contrast) {
 	i2cBuff[0] = 0x81;
 	i2cBuff[1] = contrast;
-	i2cWrite(SSD1306_I2C_CMD, i2cBuff, 2);
+	busWrite(SSD1306_I2C_CMD, i2cBuff, 2);
 }
 
 
 // Switch On/Off the display
 void ssd1306_SetDisplayOnOff(uint8_t onOff) {
 	i2cBuff[0] = 0xAE + (onOff & 0x01);
-	i2cWrite(SSD1306_I2C_CMD, i2cBuff, 1);
+	busWrite(SSD1306_I2C_CMD, i2cBuff, 1);
+}
+
+
+// Deep sleep: display off, then charge pump off
+// The GDDRAM and the configuration survive, so no init string is needed to wake
+void ssd1306_Sleep(void) {
+	i2cBuff[0] = 0xAE;
+	i2cBuff[1] = 0x8D;
+	i2cBuff[2] = 0x10;
+	busWrite(SSD1306_I2C_CMD, i2cBuff, 3);
+}
+
+
+// Fast wake from ssd1306_Sleep: charge pump on, contrast, display on
+// The panel shows the retained RAM content once the pump has ramped up
+void ssd1306_Wake(uint8_t contrast) {
+	i2cBuff[0] = 0x8D;
+	i2cBuff[1] = 0x14;
+	i2cBuff[2] = 0x81;
+	i2cBuff[3] = contrast;
+	i2cBuff[4] = 0xAF;
+	busWrite(SSD1306_I2C_CMD, i2cBuff, 5);
+}
+
+
+#ifdef SSD1306_BAND_BUFFER
+// Compose a window into the RAM band: no bus traffic until ssd1306_BandFlush
+// The window is clipped to the band; later windows overwrite earlier ones
+// Only the columns whose content changed are marked for the flush
+void ssd1306_BandBlit(uint8_t xpos, uint8_t ypos, uint8_t width, uint8_t pages, ssd1306Gen_t gen, void *arg) {
+	uint8_t out[SSD1306_BAND_PAGES];
+	uint8_t *column;
+	uint8_t changed;
+
+	xpos &= 0x7F;						// Prevent column overflow
+	if ((ypos < SSD1306_BAND_FIRST) || (ypos >= (SSD1306_BAND_FIRST + SSD1306_BAND_PAGES))) {
+		return;
+	}
+	if (width > (SSD1306_WIDTH - xpos)) {
+		width = SSD1306_WIDTH - xpos;
+	}
+	if (pages > (SSD1306_BAND_FIRST + SSD1306_BAND_PAGES - ypos)) {
+		pages = SSD1306_BAND_FIRST + SSD1306_BAND_PAGES - ypos;
+	}
+
+	busStatus(ssd1306_TransportFlush());	// The last burst may still be reading the band
+	column = &band[(xpos * SSD1306_BAND_PAGES) + (ypos - SSD1306_BAND_FIRST)];
+	for (uint8_t c = 0; c < width; c++) {
+		gen(c, pages, out, arg);
+		changed = 0;
+		for (uint8_t k = 0; k < pages; k++) {
+			changed |= column[k] ^ out[k];
+			column[k] = out[k];
+		}
+		if (changed) {
+			if ((xpos + c) < bandFirst) {
+				bandFirst = xpos + c;
+			}
+			if ((xpos + c) > bandLast) {
+				bandLast = xpos + c;
+			}
+		}
+		column += SSD1306_BAND_PAGES;
+	}
+}
+
+
+// Send the changed columns of the band: one window command, then one transfer
+// (with the I2C DMA transport, a single DMA transfer straight from the band)
+// Nothing is sent when the band is unchanged
+void ssd1306_BandFlush(void) {
+	uint32_t start;
+	uint16_t length;
+
+	if (bandFirst > bandLast) {
+		return;
+	}
+	length = (bandLast - bandFirst + 1) * SSD1306_BAND_PAGES;
+	i2cBuff[0] = 0x21;					// Set column window
+	i2cBuff[1] = bandFirst;
+	i2cBuff[2] = bandLast;
+	i2cBuff[3] = 0x22;					// Set page window
+	i2cBuff[4] = SSD1306_BAND_FIRST;
+	i2cBuff[5] = SSD1306_BAND_FIRST + SSD1306_BAND_PAGES - 1;
+	busWrite(SSD1306_I2C_CMD, i2cBuff, 6);
+	if (busFault) {
+		busStats.dropped++;
+		return;
+	}
+
+	start = SSD1306_TIMESTAMP();
+	busStatus(ssd1306_TransportBurst(SSD1306_I2C_DATA, &band[bandFirst * SSD1306_BAND_PAGES], length));
+	busStats.busyTime += SSD1306_TIMESTAMP() - start;
+	busStats.transactions++;
+	busStats.bytes += length;
+	bandFirst = SSD1306_WIDTH;
+	bandLast = 0;
+}
+#endif
+
+
+// Read the bus statistics
+const ssd1306Stats_t *ssd1306_GetStats(void) {
+	return &busStats;
 }
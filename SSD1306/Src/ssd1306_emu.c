@@ -0,0 +1,228 @@
+/**
+ * @file   ssd1306_emu.c
+ * @brief  Host SSD1306 emulator: decodes the driver's command/data stream into a framebuffer.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ssd1306_emu.h"
+
+// Emulator variables
+static ssd1306Emu_t emu;
+static uint8_t cmdCode;			// Command waiting for its parameters
+static uint8_t cmdArgs[6];
+static uint8_t cmdCount, cmdNeeded;
+
+
+//  Number of parameter bytes following a command code (datasheet command table)
+static uint8_t cmdLength(uint8_t code) {
+	switch (code) {
+	case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+	case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+		return 1;
+	case 0x21: case 0x22: case 0xA3:
+		return 2;
+	case 0x29: case 0x2A:
+		return 5;
+	case 0x26: case 0x27:
+		return 6;
+	default:
+		return 0;
+	}
+}
+
+
+//  Execute a complete command
+static void cmdExecute(uint8_t code, const uint8_t *arg) {
+	if (code <= 0x0F) {									// Lower column nibble
+		emu.col = (emu.col & 0xF0) | code;
+	} else if (code <= 0x1F) {							// Upper column nibble
+		emu.col = (uint8_t) (((code & 0x07) << 4) | (emu.col & 0x0F));
+	} else if ((code >= 0xB0) && (code <= 0xB7)) {		// Page start
+		emu.page = code & 0x07;
+	} else if ((code >= 0x40) && (code <= 0x7F)) {		// Display start line (no effect on the RAM)
+	} else {
+		switch (code) {
+		case 0x20:
+			emu.addrMode = arg[0] & 0x03;
+			break;
+		case 0x21:
+			emu.colStart = emu.col = arg[0] & 0x7F;
+			emu.colEnd = arg[1] & 0x7F;
+			break;
+		case 0x22:
+			emu.pageStart = emu.page = arg[0] & 0x07;
+			emu.pageEnd = arg[1] & 0x07;
+			break;
+		case 0x81:
+			emu.contrast = arg[0];
+			break;
+		case 0x8D:
+			emu.chargePump = (arg[0] & 0x04) ? 1 : 0;
+			break;
+		case 0xA0: case 0xA1:
+			emu.segRemap = code & 0x01;
+			break;
+		case 0xC0: case 0xC8:
+			emu.comRemap = (code == 0xC8);
+			break;
+		case 0xAE: case 0xAF:
+			emu.displayOn = code & 0x01;
+			break;
+		case 0x26: case 0x27: case 0x29: case 0x2A: case 0x2E: case 0x2F: case 0xA3:
+		case 0xA4: case 0xA5: case 0xA6: case 0xA7: case 0xA8:
+		case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0xE3:
+			break;										// Scroll, timing and panel setup: no effect on the RAM
+		default:
+			emu.unknown++;
+			break;
+		}
+	}
+}
+
+
+//  Store one GDDRAM byte and advance the pointer as the addressing mode does
+static void dataWrite(uint8_t byte) {
+	emu.ram[emu.page & 0x07][emu.col & 0x7F] = byte;
+
+	switch (emu.addrMode) {
+	case SSD1306_EMU_HORIZONTAL:
+		if (emu.col++ >= emu.colEnd) {
+			emu.col = emu.colStart;
+			emu.page = (emu.page >= emu.pageEnd) ? emu.pageStart : (emu.page + 1);
+		}
+		break;
+	case SSD1306_EMU_VERTICAL:
+		if (emu.page++ >= emu.pageEnd) {
+			emu.page = emu.pageStart;
+			emu.col = (emu.col >= emu.colEnd) ? emu.colStart : (emu.col + 1);
+		}
+		break;
+	default:											// Page mode: wraps inside the page
+		emu.col = (emu.col + 1) & 0x7F;
+		break;
+	}
+}
+
+
+//  Power-on reset state (datasheet defaults: page addressing, full window, display off)
+void ssd1306_EmuInit(void) {
+	memset(&emu, 0, sizeof(emu));
+	emu.addrMode = SSD1306_EMU_PAGE;
+	emu.colEnd = SSD1306_EMU_COLUMNS - 1;
+	emu.pageEnd = SSD1306_EMU_PAGES - 1;
+	emu.contrast = 0x7F;
+	cmdCount = cmdNeeded = 0;
+}
+
+
+//  Decode every transfer as it is recorded
+void ssd1306_EmuAttach(void) {
+	ssd1306_HostSetSink(ssd1306_EmuFeed);
+}
+
+
+//  Decode one transfer: the control byte selects commands (0x00) or GDDRAM data (0x40)
+//  A command may continue in the next command transfer, as on the controller
+void ssd1306_EmuFeed(uint8_t mode, const uint8_t *data, uint16_t length) {
+	emu.frame.transactions++;
+
+	if (mode == SSD1306_I2C_DATA) {
+		emu.frame.dataBytes += length;
+		while (length--) {
+			dataWrite(*data++);
+		}
+		return;
+	}
+
+	emu.frame.cmdBytes += length;
+	while (length--) {
+		if (cmdNeeded) {
+			cmdArgs[cmdCount++] = *data++;
+			if (cmdCount == cmdNeeded) {
+				cmdExecute(cmdCode, cmdArgs);
+				cmdCount = cmdNeeded = 0;
+			}
+		} else {
+			cmdCode = *data++;
+			cmdNeeded = cmdLength(cmdCode);
+			if (!cmdNeeded) {
+				cmdExecute(cmdCode, cmdArgs);
+			}
+		}
+	}
+}
+
+
+//  Decode a recorded log ([control][length low][length high][payload] per transfer)
+void ssd1306_EmuReplay(const ssd1306HostLog_t *log) {
+	uint32_t i = 0;
+	uint16_t length;
+
+	while ((i + 3) <= log->length) {
+		length = (uint16_t) (log->stream[i + 1] | (log->stream[i + 2] << 8));
+		if ((i + 3 + length) > log->length) {
+			break;
+		}
+		ssd1306_EmuFeed(log->stream[i], &log->stream[i + 3], length);
+		i += 3 + length;
+	}
+}
+
+
+//  Close the current frame: its traffic becomes the last frame and is added to the total
+const ssd1306EmuTraffic_t *ssd1306_EmuFrameEnd(void) {
+	emu.last = emu.frame;
+	emu.total.transactions += emu.frame.transactions;
+	emu.total.cmdBytes += emu.frame.cmdBytes;
+	emu.total.dataBytes += emu.frame.dataBytes;
+	memset(&emu.frame, 0, sizeof(emu.frame));
+	emu.frames++;
+	return &emu.last;
+}
+
+
+//  Framebuffer and controller state
+const ssd1306Emu_t *ssd1306_EmuGetState(void) {
+	return &emu;
+}
+
+
+//  Pixel in GDDRAM coordinates (the panel mirrors it with 0xA1/0xC8, the content is the same)
+uint8_t ssd1306_EmuGetPixel(uint8_t x, uint8_t y) {
+	if ((x >= SSD1306_EMU_COLUMNS) || (y >= (SSD1306_EMU_PAGES * 8))) {
+		return 0;
+	}
+	return (emu.ram[y >> 3][x] >> (y & 0x07)) & 0x01;
+}
+
+
+//  Write the visible area as a binary PBM (P4): 1 = black in PBM, so lit pixels are black
+int ssd1306_EmuWritePbm(const char *path) {
+	FILE *f = fopen(path, "wb");
+	uint8_t row[SSD1306_WIDTH / 8];
+
+	if (f == NULL) {
+		return -1;
+	}
+	fprintf(f, "P4\n%d %d\n", SSD1306_WIDTH, SSD1306_HEIGHT);
+	for (uint8_t y = 0; y < SSD1306_HEIGHT; y++) {
+		memset(row, 0, sizeof(row));
+		for (uint8_t x = 0; x < SSD1306_WIDTH; x++) {
+			if (ssd1306_EmuGetPixel(x, y)) {
+				row[x >> 3] |= (uint8_t) (0x80 >> (x & 0x07));
+			}
+		}
+		fwrite(row, 1, sizeof(row), f);
+	}
+	return (fclose(f) == 0) ? 0 : -1;
+}
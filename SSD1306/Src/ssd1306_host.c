@@ -0,0 +1,101 @@
+/**
+ * @file   ssd1306_host.c
+ * @brief  SSD1306 transport: host recorder (SSD1306_TRANSPORT_HOST).
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include <string.h>
+
+#include "ssd1306.h"
+
+// Every transfer is counted and appended to the log as
+// [control][length low][length high][payload], and forwarded to the sink if set
+
+// Recorder variables
+static ssd1306HostLog_t hostLog;
+static ssd1306HostSink_t hostSink = NULL;
+static uint8_t hostFail;			// Write attempts still to fail
+
+
+//  No bus: start from an empty log
+void ssd1306_TransportInit(ssd1306Bus_t *bus) {
+	(void) bus;
+	ssd1306_HostReset();
+}
+
+
+//  Record one transfer (failed attempts are not recorded, as on a bus that NACKs)
+uint8_t ssd1306_TransportWrite(uint8_t mode, const uint8_t *data, uint16_t length) {
+	uint8_t failed = 0;
+
+	while (hostFail) {
+		hostFail--;
+		if (SSD1306_BUS_GAVE_UP(++failed)) {
+			return failed;
+		}
+	}
+
+	hostLog.transactions++;
+	hostLog.bytes += length;
+
+	if ((hostLog.length + 3 + length) <= SSD1306_HOST_LOG_SIZE) {
+		hostLog.stream[hostLog.length++] = mode;
+		hostLog.stream[hostLog.length++] = (uint8_t) length;
+		hostLog.stream[hostLog.length++] = (uint8_t) (length >> 8);
+		memcpy(&hostLog.stream[hostLog.length], data, length);
+		hostLog.length += length;
+	} else {
+		hostLog.overflow++;
+	}
+
+	if (hostSink != NULL) {
+		hostSink(mode, data, length);
+	}
+	return failed;
+}
+
+
+//  Burst: recorded as one transfer
+uint8_t ssd1306_TransportBurst(uint8_t mode, const uint8_t *data, uint16_t length) {
+	return ssd1306_TransportWrite(mode, data, length);
+}
+
+
+//  Nothing pending
+uint8_t ssd1306_TransportFlush(void) {
+	return 0;
+}
+
+
+//  Clear the log and the counters (the sink is kept)
+void ssd1306_HostReset(void) {
+	hostLog.transactions = 0;
+	hostLog.bytes = 0;
+	hostLog.length = 0;
+	hostLog.overflow = 0;
+}
+
+
+//  Recorded transfers
+const ssd1306HostLog_t *ssd1306_HostGetLog(void) {
+	return &hostLog;
+}
+
+
+//  Forward every transfer to a decoder as well (NULL = log only)
+void ssd1306_HostSetSink(ssd1306HostSink_t sink) {
+	hostSink = sink;
+}
+
+
+//  Fault injection: the next count write attempts fail
+void ssd1306_HostFail(uint8_t count) {
+	hostFail = count;
+}
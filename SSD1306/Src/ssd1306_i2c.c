@@ -0,0 +1,52 @@
+/**
+ * @file   ssd1306_i2c.c
+ * @brief  SSD1306 transport: blocking I2C (SSD1306_TRANSPORT_I2C, default).
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include "ssd1306.h"
+
+// I2C variables
+static I2C_HandleTypeDef *i2cHandle = NULL;
+
+
+//  Store the I2C handle and set the bus speed
+void ssd1306_TransportInit(ssd1306Bus_t *bus) {
+	i2cHandle = bus;
+	ssd1306_I2cConfigure(i2cHandle);
+}
+
+
+//  Write one transfer: control byte (command or data) followed by the payload
+//  Returns when the STOP condition has been sent, or after the last retry
+//  Every failed attempt (NACK, bus error, timeout) is followed by a bus recovery
+uint8_t ssd1306_TransportWrite(uint8_t mode, const uint8_t *data, uint16_t length) {
+	uint8_t failed = 0;
+
+	while (HAL_I2C_Mem_Write(i2cHandle, SSD1306_I2C_ADDR, mode, 1, (uint8_t *) data, length, SSD1306_BUS_TIMEOUT(length)) != HAL_OK) {
+		ssd1306_I2cRecover(i2cHandle);
+		if (SSD1306_BUS_GAVE_UP(++failed)) {
+			break;
+		}
+	}
+	return failed;
+}
+
+
+//  Burst: a plain write (complete on return)
+uint8_t ssd1306_TransportBurst(uint8_t mode, const uint8_t *data, uint16_t length) {
+	return ssd1306_TransportWrite(mode, data, length);
+}
+
+
+//  Nothing pending: every write is complete on return
+uint8_t ssd1306_TransportFlush(void) {
+	return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file   ssd1306_i2c_bus.c
+ * @brief  SSD1306 I2C bus setup and fault recovery (I2C and I2C DMA transports).
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include "ssd1306.h"
+
+// Half SCL period of the recovery clock (about 5 us at 16 MHz, slower than any bus speed)
+#define RECOVER_DELAY()		for (volatile uint8_t d = 16; d; d--)
+
+
+//  Bus timing for SSD1306_I2C_SPEED; Fast-mode Plus also needs the 20 mA drive on the pins
+//  HAL_I2C_Init disables the peripheral while TIMINGR changes (and runs the MSP init after a DeInit)
+void ssd1306_I2cConfigure(I2C_HandleTypeDef *hi2c) {
+	hi2c->Init.Timing = SSD1306_I2C_TIMING;
+	HAL_I2C_Init(hi2c);
+#if (SSD1306_I2C_SPEED == 1000)
+	HAL_I2CEx_EnableFastModePlus(SSD1306_I2C_FMP);
+#endif
+}
+
+
+//  Free a stuck bus and restart I2C1
+//  A slave holding SDA low (reset in the middle of a byte) releases it within 9 SCL pulses;
+//  a STOP then leaves the bus idle. I2C1 is de-initialized, so its state machine restarts too.
+void ssd1306_I2cRecover(I2C_HandleTypeDef *hi2c) {
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	HAL_I2C_DeInit(hi2c);
+
+	HAL_GPIO_WritePin(SSD1306_I2C_GPIO_Port, SSD1306_I2C_SDA_Pin | SSD1306_I2C_SCL_Pin, GPIO_PIN_SET);
+	GPIO_InitStruct.Pin = SSD1306_I2C_SDA_Pin | SSD1306_I2C_SCL_Pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+	GPIO_InitStruct.Pull = GPIO_PULLUP;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+	HAL_GPIO_Init(SSD1306_I2C_GPIO_Port, &GPIO_InitStruct);
+
+	for (uint8_t i = 0; i < 9; i++) {
+		if (HAL_GPIO_ReadPin(SSD1306_I2C_GPIO_Port, SSD1306_I2C_SDA_Pin) == GPIO_PIN_SET) {
+			break;
+		}
+		HAL_GPIO_WritePin(SSD1306_I2C_GPIO_Port, SSD1306_I2C_SCL_Pin, GPIO_PIN_RESET);
+		RECOVER_DELAY();
+		HAL_GPIO_WritePin(SSD1306_I2C_GPIO_Port, SSD1306_I2C_SCL_Pin, GPIO_PIN_SET);
+		RECOVER_DELAY();
+	}
+
+	// STOP: SDA rises while SCL is high
+	HAL_GPIO_WritePin(SSD1306_I2C_GPIO_Port, SSD1306_I2C_SCL_Pin, GPIO_PIN_RESET);
+	RECOVER_DELAY();
+	HAL_GPIO_WritePin(SSD1306_I2C_GPIO_Port, SSD1306_I2C_SDA_Pin, GPIO_PIN_RESET);
+	RECOVER_DELAY();
+	HAL_GPIO_WritePin(SSD1306_I2C_GPIO_Port, SSD1306_I2C_SCL_Pin, GPIO_PIN_SET);
+	RECOVER_DELAY();
+	HAL_GPIO_WritePin(SSD1306_I2C_GPIO_Port, SSD1306_I2C_SDA_Pin, GPIO_PIN_SET);
+	RECOVER_DELAY();
+
+	ssd1306_I2cConfigure(hi2c);		// Pins back to I2C (MSP init), timing restored
+}
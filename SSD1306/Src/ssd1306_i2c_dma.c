@@ -0,0 +1,127 @@
+/**
+ * @file   ssd1306_i2c_dma.c
+ * @brief  SSD1306 transport: I2C with DMA (SSD1306_TRANSPORT_I2C_DMA).
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include <string.h>
+
+#include "ssd1306.h"
+
+// Needs the I2C1 TX DMA channel linked to the handle (hi2c->hdmatx) and the
+// I2C1 and DMA channel interrupts enabled (CubeMX: I2C1 DMA Settings, NVIC)
+
+// I2C variables
+static I2C_HandleTypeDef *i2cHandle = NULL;
+static uint8_t dmaBuff[SSD1306_DMA_BUFF_SIZE];	// The caller reuses its buffer at once
+static volatile uint8_t dmaBusy;
+static volatile uint8_t dmaError;
+static uint32_t dmaTick, dmaTimeout;			// Transfer in progress: start tick and limit (ms)
+static const uint8_t *dmaData;					// Transfer in progress, kept for a retry
+static uint16_t dmaLength;
+static uint8_t dmaMode;
+
+
+//  Store the I2C handle and set the bus speed
+void ssd1306_TransportInit(ssd1306Bus_t *bus) {
+	i2cHandle = bus;
+	dmaBusy = 0;
+	dmaError = 0;
+	ssd1306_I2cConfigure(i2cHandle);
+}
+
+
+//  Start one DMA transfer (the previous one is complete)
+//  The transfer is kept, so the flush can restart it after a bus recovery
+static void dmaStart(uint8_t mode, const uint8_t *data, uint16_t length) {
+	dmaMode = mode;
+	dmaData = data;
+	dmaLength = length;
+	dmaError = 0;
+	dmaBusy = 1;
+	dmaTick = HAL_GetTick();
+	dmaTimeout = SSD1306_BUS_TIMEOUT(length);
+	if (HAL_I2C_Mem_Write_DMA(i2cHandle, SSD1306_I2C_ADDR, mode, 1, (uint8_t *) data, length) != HAL_OK) {
+		dmaError = 1;
+		dmaBusy = 0;
+	}
+}
+
+
+//  Write one transfer: copy the payload and start the DMA, then return while the bus runs
+//  The next write (or a flush) waits for this one; longer payloads are split
+//  Returns the failed attempts of the transfers it waited for (the worst one)
+uint8_t ssd1306_TransportWrite(uint8_t mode, const uint8_t *data, uint16_t length) {
+	uint16_t chunk;
+	uint8_t failed = 0, f;
+
+	while (length > 0) {
+		chunk = (length > SSD1306_DMA_BUFF_SIZE) ? SSD1306_DMA_BUFF_SIZE : length;
+		f = ssd1306_TransportFlush();
+		if (f > failed) {
+			failed = f;
+		}
+		memcpy(dmaBuff, data, chunk);
+		dmaStart(mode, dmaBuff, chunk);
+		data += chunk;
+		length -= chunk;
+	}
+	return failed;
+}
+
+
+//  Burst: one DMA transfer straight from the caller's buffer (no copy, no split)
+//  The caller leaves the data untouched until the next flush
+uint8_t ssd1306_TransportBurst(uint8_t mode, const uint8_t *data, uint16_t length) {
+	uint8_t failed = ssd1306_TransportFlush();
+
+	dmaStart(mode, data, length);
+	return failed;
+}
+
+
+//  Wait for the transfer in progress (same timeout as the blocking backend)
+//  A failed or timed out transfer is restarted after a bus recovery, then given up
+uint8_t ssd1306_TransportFlush(void) {
+	uint8_t failed = 0;
+
+	for (;;) {
+		while (dmaBusy && ((HAL_GetTick() - dmaTick) <= dmaTimeout)) {
+		}
+		if (!dmaBusy && !dmaError) {
+			break;
+		}
+		dmaBusy = 0;
+		ssd1306_I2cRecover(i2cHandle);		// Also stops a DMA still running
+		if (SSD1306_BUS_GAVE_UP(++failed)) {
+			dmaError = 0;
+			break;
+		}
+		dmaStart(dmaMode, dmaData, dmaLength);
+	}
+	return failed;
+}
+
+
+//  Transfer complete (interrupt context)
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+	if (hi2c == i2cHandle) {
+		dmaBusy = 0;
+	}
+}
+
+
+//  Transfer failed (interrupt context): reported by the next flush
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+	if (hi2c == i2cHandle) {
+		dmaError = 1;
+		dmaBusy = 0;
+	}
+}
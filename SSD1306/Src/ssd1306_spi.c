@@ -0,0 +1,59 @@
+/**
+ * @file   ssd1306_spi.c
+ * @brief  SSD1306 transport: 4-wire SPI (SSD1306_TRANSPORT_SPI).
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include "ssd1306.h"
+
+// Needs SPI enabled in CubeMX (up to 10 MHz for the SSD1306, about 10x the
+// 400 kHz I2C bandwidth) and two outputs named in main.h:
+// SSD1306_DC (low = command, high = data) and SSD1306_CS (active low)
+#if !defined(SSD1306_DC_Pin) || !defined(SSD1306_CS_Pin)
+#error "SSD1306_TRANSPORT_SPI needs the SSD1306_DC and SSD1306_CS pins (main.h)"
+#endif
+
+// SPI variables
+static SPI_HandleTypeDef *spiHandle = NULL;
+
+
+//  Store the SPI handle and deselect the display
+void ssd1306_TransportInit(ssd1306Bus_t *bus) {
+	spiHandle = bus;
+	HAL_GPIO_WritePin(SSD1306_CS_GPIO_Port, SSD1306_CS_Pin, GPIO_PIN_SET);
+}
+
+
+//  Write one transfer: the control byte becomes the D/C level, CS frames the payload
+//  SPI has no bus state to recover: a failed transmit (timeout) is just repeated
+uint8_t ssd1306_TransportWrite(uint8_t mode, const uint8_t *data, uint16_t length) {
+	uint8_t failed = 0;
+	HAL_StatusTypeDef status;
+
+	HAL_GPIO_WritePin(SSD1306_DC_GPIO_Port, SSD1306_DC_Pin, (mode == SSD1306_I2C_DATA) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+	do {
+		HAL_GPIO_WritePin(SSD1306_CS_GPIO_Port, SSD1306_CS_Pin, GPIO_PIN_RESET);
+		status = HAL_SPI_Transmit(spiHandle, (uint8_t *) data, length, SSD1306_BUS_TIMEOUT(length));
+		HAL_GPIO_WritePin(SSD1306_CS_GPIO_Port, SSD1306_CS_Pin, GPIO_PIN_SET);
+	} while ((status != HAL_OK) && !SSD1306_BUS_GAVE_UP(++failed));
+	return failed;
+}
+
+
+//  Burst: a plain write (complete on return)
+uint8_t ssd1306_TransportBurst(uint8_t mode, const uint8_t *data, uint16_t length) {
+	return ssd1306_TransportWrite(mode, data, length);
+}
+
+
+//  Nothing pending: every write is complete on return
+uint8_t ssd1306_TransportFlush(void) {
+	return 0;
+}
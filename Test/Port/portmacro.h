@@ -0,0 +1,68 @@
+/**
+ * @file   portmacro.h
+ * @brief  FreeRTOS port for the host tests: types and macros only.
+ *
+ *         Used in place of portable/GCC/ARM_CM0 when Core sources are
+ *         compiled on the host. There is no scheduler: interrupt masking is
+ *         a no-op, critical sections call the host stubs and a failed
+ *         configASSERT reaches Error_Handler (host_stubs.c).
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+// Same widths as the Cortex-M0+ port
+typedef uint32_t			StackType_t;
+typedef long				BaseType_t;
+typedef unsigned long		UBaseType_t;
+typedef uint32_t			TickType_t;
+
+#define portCHAR			char
+#define portFLOAT			float
+#define portDOUBLE			double
+#define portLONG			long
+#define portSHORT			short
+#define portSTACK_TYPE		uint32_t
+#define portBASE_TYPE		long
+
+#define portMAX_DELAY				((TickType_t) 0xffffffffUL)
+#define portTICK_TYPE_IS_ATOMIC		1
+#define portARCH_NAME				"Host"
+#define portSTACK_GROWTH			(-1)
+#define portTICK_PERIOD_MS			((TickType_t) 1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT			8
+#define portPRIVILEGE_BIT			(0x0UL)
+#define portNOP()
+#define portINLINE					__inline
+#define portFORCE_INLINE			inline __attribute__((always_inline))
+#define portDONT_DISCARD			__attribute__((used))
+
+// No scheduler and no interrupts on the host
+extern void vPortEnterCritical(void);
+extern void vPortExitCritical(void);
+
+#define portYIELD()
+#define portEND_SWITCHING_ISR(xSwitchRequired)		((void) (xSwitchRequired))
+#define portYIELD_FROM_ISR(x)						portEND_SWITCHING_ISR(x)
+#define portSET_INTERRUPT_MASK_FROM_ISR()			0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)		((void) (x))
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()						vPortEnterCritical()
+#define portEXIT_CRITICAL()							vPortExitCritical()
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime)	((void) (xExpectedIdleTime))
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters)	void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters)			void vFunction(void *pvParameters)
+#define portMEMORY_BARRIER()
+
+#endif  // PORTMACRO_H
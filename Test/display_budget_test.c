@@ -0,0 +1,332 @@
+/**
+ * @file   display_budget_test.c
+ * @brief  Host test: displayTask bus traffic against the DISPLAY_BUDGET_* bounds.
+ *
+ *         Runs the real displayTask on the host recorder transport with the
+ *         emulator attached, and feeds it a script of events that visits
+ *         every screen with every button. After each step the recorded
+ *         traffic (ssd1306_HostGetLog) is checked against the budgets of the
+ *         renders that step may run, and the key screens against their
+ *         golden frames. Built once per SSD1306_BAND_BUFFER mode: both
+ *         modes must draw the same frames.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include <setjmp.h>
+#include <stdio.h>
+
+#include "host_stubs.h"
+#include "display_task.h"
+#include "sys_stats.h"
+#include "ssd1306_emu.h"
+#include "test_common.h"
+
+// Step budgets: bit mask of displayBudgetEnum, plus the display wake or sleep command
+#define BUDGET(b)			(1U << DISP_BUDGET_##b)
+#define BUDGET_POWER		(1U << DISP_BUDGETS)
+#define BUDGET_POWER_TX		1		// ssd1306_Wake / ssd1306_Sleep: one command transaction
+#define BUDGET_POWER_BYTES	5
+
+// Script step
+typedef struct {
+	uint32_t event;			// Notification to displayTask, 0 = the wait times out
+	uint16_t advance;		// ms that pass before a timeout
+	uint8_t budgets;		// Renders the step may run (BUDGET bits, none = no traffic)
+	const char *frame;		// Golden frame after the step (NULL = not compared)
+} budgetStep_t;
+
+#define EVENT(ev, b)		{DISP_EV_##ev, 0, (b), NULL}
+#define EVENT_FRAME(ev, b, f)	{DISP_EV_##ev, 0, (b), (f)}
+#define WAIT(ms, b)			{0, (ms), (b), NULL}
+#define WAIT_FRAME(ms, b, f)	{0, (ms), (b), (f)}
+
+static const budgetStep_t script[] = {
+		// First boot: silent hours → calibration → time (display off until now)
+		EVENT_FRAME(FORCE_SETUP, BUDGET(ENTER) | BUDGET_POWER, "setup_silent"),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT(BTN_SET_LONG, BUDGET(EDIT)),
+		EVENT(BTN_INC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_DEC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_CHORD, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT_FRAME(BTN_SET, BUDGET(ENTER), "setup_correction"),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT(BTN_SET_LONG, BUDGET(EDIT)),
+		EVENT(BTN_INC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_DEC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_CHORD, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT_FRAME(BTN_SET, BUDGET(ENTER), "setup_rtc"),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT(BTN_SET_LONG, BUDGET(EDIT)),
+		EVENT(BTN_INC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_DEC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_CHORD, BUDGET(EDIT)),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT_FRAME(BTN_SET, BUDGET(EDIT), "setup_rtc_weekday"),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(ENTER)),
+
+		// Drum synchronization
+		EVENT_FRAME(SYN_START, BUDGET(ENTER) | BUDGET(MSG), "sync"),
+		EVENT(SYN_SRC_HOUR, BUDGET(MSG)),
+		EVENT(SYN_SRC_DAY, BUDGET(MSG)),
+		EVENT(SYN_SET_HOUR, BUDGET(MSG)),
+		EVENT(SYN_SET_MIN, BUDGET(MSG)),
+		EVENT(SYN_END, BUDGET(MSG) | BUDGET(CLEAR)),
+
+		// Clock face: first refresh after the clear, then unchanged
+		WAIT_FRAME(20, BUDGET(CLOCK), "clock"),
+		WAIT(600, BUDGET(CLOCK)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+
+		// Diagnostic pages: forward, backward across the partial last page, refresh
+		EVENT_FRAME(BTN_CHORD, BUDGET(ENTER), "diag"),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_CHORD, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT_FRAME(BTN_DEC, BUDGET(EDIT), "diag_last"),
+		WAIT(1000, BUDGET(EDIT)),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+		EVENT(BTN_CHORD, BUDGET(ENTER)),
+		EVENT(BTN_INC_LONG, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+		EVENT(BTN_CHORD, BUDGET(ENTER)),
+		EVENT(BTN_DEC_LONG, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+		EVENT(BTN_CHORD, BUDGET(ENTER)),
+		EVENT(BTN_SET_LONG, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+		// Saturated negative value (flip offset, page 2): the sign stays right of the label
+		EVENT(BTN_CHORD, BUDGET(ENTER)),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT_FRAME(BTN_INC, BUDGET(EDIT), "diag_negative"),
+		EVENT(BTN_SET, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+
+		// Silent hours, then the weekly schedule from there
+		EVENT_FRAME(BTN_INC_LONG, BUDGET(ENTER), "silent"),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT(BTN_INC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_DEC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_CHORD, BUDGET(EDIT)),
+		EVENT_FRAME(BTN_SET_LONG, BUDGET(ENTER), "week"),
+		EVENT_FRAME(BTN_SET, BUDGET(EDIT), "week_toggled"),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_CHORD, BUDGET(EDIT)),
+		EVENT(BTN_INC_LONG, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+		EVENT(BTN_INC_LONG, BUDGET(ENTER)),
+		EVENT(BTN_SET_LONG, BUDGET(ENTER)),
+		EVENT(BTN_DEC_LONG, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+		EVENT(BTN_INC_LONG, BUDGET(ENTER)),
+		EVENT(BTN_SET_LONG, BUDGET(ENTER)),
+		EVENT(BTN_SET_LONG, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+		EVENT(BTN_INC_LONG, BUDGET(ENTER)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+
+		// Calibration
+		EVENT_FRAME(BTN_DEC_LONG, BUDGET(ENTER), "correction"),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT(BTN_SET_LONG, BUDGET(EDIT)),
+		EVENT(BTN_INC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_DEC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_CHORD, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(ENTER)),
+		WAIT(20, BUDGET(CLOCK)),
+
+		// Time setting, committed: back to synchronization
+		EVENT_FRAME(BTN_SET_LONG, BUDGET(ENTER), "rtc"),
+		EVENT(BTN_INC, BUDGET(EDIT)),
+		EVENT(BTN_DEC, BUDGET(EDIT)),
+		EVENT(BTN_SET_LONG, BUDGET(EDIT)),
+		EVENT(BTN_INC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_DEC_LONG, BUDGET(EDIT)),
+		EVENT(BTN_CHORD, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_SET, BUDGET(ENTER)),
+		EVENT(SYN_START, BUDGET(ENTER) | BUDGET(MSG)),
+		EVENT(SYN_END, BUDGET(MSG) | BUDGET(CLEAR)),
+		WAIT(20, BUDGET(CLOCK)),
+
+		// Auto shut off, then a button only wakes the display
+		WAIT(DISPLAY_OFF_TIMEOUT + 100, BUDGET(CLOCK) | BUDGET_POWER),
+		WAIT(600, BUDGET(CLOCK)),
+		EVENT(BTN_INC, BUDGET_POWER),
+		WAIT_FRAME(600, BUDGET(CLOCK), "clock_awake"),
+		EVENT(BTN_CHORD, BUDGET(ENTER)),
+		WAIT(DISPLAY_OFF_TIMEOUT + 100, BUDGET(EDIT) | BUDGET(CLEAR) | BUDGET_POWER),
+		EVENT(BTN_SET, BUDGET_POWER),
+		WAIT(20, BUDGET(CLOCK)),
+
+		// Shut off inside the week editor: its rows are cleared, the clock face comes back alone
+		EVENT(BTN_INC_LONG, BUDGET(ENTER)),
+		EVENT(BTN_SET_LONG, BUDGET(ENTER)),
+		WAIT(DISPLAY_OFF_TIMEOUT + 100, BUDGET(CLEAR) | BUDGET_POWER),
+		EVENT(BTN_SET, BUDGET_POWER),
+		WAIT_FRAME(20, BUDGET(CLOCK), "clock_awake"),
+
+		// Sensor error: sticky screen, buttons ignored
+		EVENT_FRAME(ERR_SNS_HOUR, BUDGET(ENTER) | BUDGET(MSG), "error"),
+		EVENT(BTN_SET, BUDGET(EDIT)),
+		EVENT(BTN_CHORD, BUDGET(EDIT)),
+		WAIT(1000, 0),
+};
+
+static const char *const budgetName[DISP_BUDGETS] = {"CLEAR", "CLOCK", "ENTER", "EDIT", "MSG"};
+
+#define SCRIPT_STEPS		(sizeof(script) / sizeof(script[0]))
+
+static jmp_buf scriptEnd;
+static uint32_t step;				// Next step of the script
+static displayBudget_t worst[DISP_BUDGETS];	// Worst traffic of the steps bounded by one budget only
+
+
+//  Upper bound of one step: sum of its budgets
+static void budgetBound(uint8_t budgets, uint32_t *tx, uint32_t *bytes) {
+	*tx = 0;
+	*bytes = 0;
+	for (uint8_t i = 0; i < DISP_BUDGETS; i++) {
+		if (budgets & (1U << i)) {
+			*tx += displayBudget[i].transactions;
+			*bytes += displayBudget[i].bytes;
+		}
+	}
+	if (budgets & BUDGET_POWER) {
+		*tx += BUDGET_POWER_TX;
+		*bytes += BUDGET_POWER_BYTES;
+	}
+}
+
+
+//  Check the step just completed by displayTask
+static void stepCheck(uint32_t index) {
+	const budgetStep_t *done = &script[index];
+	const ssd1306HostLog_t *log = ssd1306_HostGetLog();
+	uint32_t maxTx, maxBytes;
+	char what[40];
+
+	budgetBound(done->budgets, &maxTx, &maxBytes);
+	snprintf(what, sizeof(what), "step %lu (event %lu)", (unsigned long) index, (unsigned long) done->event);
+	testTraffic(what, log->transactions, log->bytes, maxTx, maxBytes);
+	for (uint8_t i = 0; i < DISP_BUDGETS; i++) {
+		if (done->budgets == (1U << i)) {
+			if (log->transactions > worst[i].transactions) {
+				worst[i].transactions = log->transactions;
+			}
+			if (log->bytes > worst[i].bytes) {
+				worst[i].bytes = log->bytes;
+			}
+		}
+	}
+	testCheck(log->overflow == 0, "host log overflow");
+	if (done->frame != NULL) {
+		testFrame(done->frame);
+	}
+}
+
+
+/**
+ * @brief  displayTask waits for its next event (host_stubs.h).
+ *
+ *         The previous step is complete at this point: its traffic and frame
+ *         are checked, the recorder is cleared and the next step is handed
+ *         over. Past the last step displayTask is left with a longjmp.
+ */
+BaseType_t stubNotifyWait(uint32_t *value, TickType_t ticks) {
+	const budgetStep_t *next;
+
+	if (step > 0) {
+		stepCheck(step - 1);
+	}
+	ssd1306_HostReset();
+	if (step == SCRIPT_STEPS) {
+		longjmp(scriptEnd, 1);
+	}
+
+	next = &script[step++];
+	if (next->event) {
+		*value = next->event;
+		return pdTRUE;
+	}
+	stubTick += (next->advance > ticks) ? pdMS_TO_TICKS(next->advance) : ticks;
+	return pdFALSE;
+}
+
+
+int main(int argc, char **argv) {
+	testInit(argc, argv);
+	sysStats.flipOffset = -1234567;		// Wider than the value field
+	ssd1306_EmuInit();
+	ssd1306_EmuAttach();
+	ssd1306_Init(NULL);
+	ssd1306_HostReset();
+
+	if (setjmp(scriptEnd) == 0) {
+		displayTask(NULL);
+	}
+
+	// Measured worst cases: the source of the DISPLAY_BUDGET_* values
+	for (uint8_t i = 0; i < DISP_BUDGETS; i++) {
+		if (worst[i].transactions == 0) {
+			continue;					// Only measured together with another render
+		}
+		printf("%-6s worst %4u / %4u of %4u / %4u\n", budgetName[i], worst[i].transactions, worst[i].bytes,
+				displayBudget[i].transactions, displayBudget[i].bytes);
+	}
+
+	// The firmware's own check must agree with the per step bounds
+	if (sysStats.busBudgetOver) {
+		printf("FAIL %lu renders over budget, last overrun: %s\n", (unsigned long) sysStats.busBudgetOver,
+				budgetName[sysStats.busBudgetLast]);
+		testFailures++;
+	}
+	testCheck(stubClockNotify == 2, "time setting commits notified to clockTask");
+#ifdef SSD1306_BAND_BUFFER
+	return testDone("display_budget_test (band)");
+#else
+	return testDone("display_budget_test");
+#endif
+}
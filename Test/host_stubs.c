@@ -0,0 +1,260 @@
+/**
+ * @file   host_stubs.c
+ * @brief  Host stand-ins for FreeRTOS, the HAL RTC and the Core services used by displayTask.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include <string.h>
+
+#include "host_stubs.h"
+#include "timers.h"
+#include "rtc_helpers.h"
+#include "sys_stats.h"
+#include "power_mgr.h"
+#include "sys_clock.h"
+
+// Only the behaviour displayTask depends on: settings are kept in RAM, the
+// run time counter stands still, every task has the same free stack
+
+#define STUB_STACK_FREE		64		// Words reported by uxTaskGetStackHighWaterMark
+
+// Stub state
+TickType_t stubTick;
+timeSnapshot_t stubTime = {
+		.hours = 12,
+		.minutes = 34,
+		.seconds = 0,
+		.weekDay = RTC_WEEKDAY_MONDAY,
+		.digits = {1, 2, 3, 4},
+		.silent = 0,
+};
+uint32_t stubClockNotify;
+
+static uint8_t silentStart = 22, silentEnd = 7;
+static uint32_t silentMap[7];
+static uint8_t calibPlus;
+static uint16_t calibValue;
+
+// Globals normally defined in rtos_init.c and sys_stats.c
+RTC_HandleTypeDef *hrtcHandle;
+TaskHandle_t displayTaskHandle;
+TaskHandle_t buttonTaskHandle;
+TaskHandle_t clockTaskHandle;
+sysStats_t sysStats;
+
+
+/*
+ *   FreeRTOS
+ */
+
+TickType_t xTaskGetTickCount(void) {
+	return stubTick;
+}
+
+
+void vTaskDelay(const TickType_t xTicksToDelay) {
+	stubTick += xTicksToDelay;
+}
+
+
+void vTaskResume(TaskHandle_t xTaskToResume) {
+	(void) xTaskToResume;
+}
+
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask) {
+	(void) xTask;
+	return STUB_STACK_FREE;
+}
+
+
+TaskHandle_t xTimerGetTimerDaemonTaskHandle(void) {
+	return NULL;
+}
+
+
+void vPortEnterCritical(void) {
+}
+
+
+void vPortExitCritical(void) {
+}
+
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+		eNotifyAction eAction, uint32_t *pulPreviousNotificationValue) {
+	(void) uxIndexToNotify;
+	(void) ulValue;
+	(void) eAction;
+	(void) pulPreviousNotificationValue;
+	if (xTaskToNotify == clockTaskHandle) {
+		stubClockNotify++;
+	}
+	return pdPASS;
+}
+
+
+BaseType_t xTaskGenericNotifyWait(UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry,
+		uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait) {
+	(void) uxIndexToWaitOn;
+	(void) ulBitsToClearOnEntry;
+	(void) ulBitsToClearOnExit;
+	return stubNotifyWait(pulNotificationValue, xTicksToWait);
+}
+
+
+/*
+ *   HAL RTC (BCD, as written by the time setting screen)
+ */
+
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format) {
+	(void) hrtc;
+	(void) Format;
+	stubTime.digits[0] = sTime->Hours >> 4;
+	stubTime.digits[1] = sTime->Hours & 0x0F;
+	stubTime.digits[2] = sTime->Minutes >> 4;
+	stubTime.digits[3] = sTime->Minutes & 0x0F;
+	stubTime.hours = stubTime.digits[0] * 10 + stubTime.digits[1];
+	stubTime.minutes = stubTime.digits[2] * 10 + stubTime.digits[3];
+	stubTime.seconds = 0;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format) {
+	(void) hrtc;
+	(void) Format;
+	stubTime.weekDay = sDate->WeekDay;
+	return HAL_OK;
+}
+
+
+/*
+ *   Time service
+ */
+
+uint32_t timeGetSnapshot(timeSnapshot_t *snap) {
+	*snap = stubTime;
+	return 0;
+}
+
+
+void timeServicePublish(void) {
+}
+
+
+/*
+ *   Silent hours and RTC calibration (rtc_helpers.c)
+ */
+
+uint8_t getSilentStartHour(void) {
+	return silentStart;
+}
+
+
+uint8_t getSilentEndHour(void) {
+	return silentEnd;
+}
+
+
+void setSilentHours(uint8_t startHour, uint8_t endHour) {
+	silentStart = startHour;
+	silentEnd = endHour;
+}
+
+
+void silentApplyWindow(void) {
+	uint32_t map = 0;
+
+	for (uint8_t hour = silentStart; hour != silentEnd; hour = (hour + 1) % 24) {
+		map |= 1UL << hour;
+	}
+	for (uint8_t day = 0; day < 7; day++) {
+		silentMap[day] = map;
+	}
+}
+
+
+uint32_t getSilentDayMap(uint8_t weekDay) {
+	return silentMap[(weekDay - 1) % 7];
+}
+
+
+void setSilentDayHour(uint8_t weekDay, uint8_t hour, uint8_t silent) {
+	if (silent) {
+		silentMap[(weekDay - 1) % 7] |= 1UL << hour;
+	} else {
+		silentMap[(weekDay - 1) % 7] &= ~(1UL << hour);
+	}
+}
+
+
+uint8_t isInSilentPeriod(void) {
+	return stubTime.silent;
+}
+
+
+void getCalibration(uint8_t *plusPulses, uint16_t *value) {
+	*plusPulses = calibPlus;
+	*value = calibValue;
+}
+
+
+void setCalibration(uint8_t plusPulses, uint16_t value) {
+	calibPlus = plusPulses;
+	calibValue = value;
+}
+
+
+void applyCalibration(void) {
+}
+
+
+void flashScheduleSettings(void) {
+}
+
+
+/*
+ *   Statistics, power and system clock
+ */
+
+uint32_t statsGetCounter(void) {
+	return 0;
+}
+
+
+void statsUpdate(void) {
+	sysStats.uptime++;
+}
+
+
+void statsRenderTime(uint32_t start) {
+	(void) start;
+}
+
+
+void powerSetDisplayOn(uint8_t on) {
+	(void) on;
+}
+
+
+uint32_t powerCurrentEstimate(void) {
+	return 0;
+}
+
+
+void sysClockBoost(uint8_t user) {
+	(void) user;
+}
+
+
+void sysClockRelease(uint8_t user) {
+	(void) user;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file   host_stubs.h
+ * @brief  Host stand-ins for FreeRTOS, the HAL RTC and the Core services used by displayTask.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef _HOST_STUBS_H_
+#define _HOST_STUBS_H_
+
+#include <stdint.h>
+
+#include "rtos_init.h"
+#include "time_service.h"
+
+// Time is simulated: the tick only moves when a wait times out or a task delays,
+// so every run produces the same frames and the same bus traffic
+
+// Stub state (readable and writable by the test)
+extern TickType_t stubTick;				// xTaskGetTickCount
+extern timeSnapshot_t stubTime;			// timeGetSnapshot (HAL_RTC_SetTime updates it)
+extern uint32_t stubClockNotify;		// Notifications sent to clockTask
+
+// Implemented by the test: the event for the next xTaskNotifyWait (pdTRUE) or a
+// timeout (pdFALSE, the test advances stubTick)
+BaseType_t stubNotifyWait(uint32_t *value, TickType_t ticks);
+
+#endif  // _HOST_STUBS_H_
@@ -0,0 +1,217 @@
+/**
+ * @file   silent_schedule_test.c
+ * @brief  Host test: weekly silent schedule loaded at boot (rtc_helpers.c).
+ *
+ *         Runs the real silentScheduleInit() with the HH-HH window in the
+ *         backup register and the settings pages of the Flash mapped at
+ *         their target address: erased (fresh device) and holding only the
+ *         record of older firmware (first boot after an upgrade). In both
+ *         cases there is no log page, and the window alone must make
+ *         isSilentAt() report the silent hours.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "rtos_init.h"
+#include "timers.h"
+#include "rtc_helpers.h"
+#include "time_service.h"
+#include "test_common.h"
+
+// Settings pages 30-31 (FLASH_SETTINGS_ADDR), mapped where the firmware reads them
+#define FLASH_MAP_SIZE		(FLASH_SETTINGS_PAGES * FLASH_PAGE_SIZE)
+
+// Stub state
+static uint32_t backup[RTC_BKP_NUMBER];
+RTC_HandleTypeDef *hrtcHandle;
+
+
+/*
+ *   HAL: backup registers and RTC, no Flash programming (only read here)
+ */
+
+uint32_t HAL_RTCEx_BKUPRead(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister) {
+	(void) hrtc;
+	return backup[BackupRegister];
+}
+
+
+void HAL_RTCEx_BKUPWrite(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister, uint32_t Data) {
+	(void) hrtc;
+	backup[BackupRegister] = Data;
+}
+
+
+HAL_StatusTypeDef HAL_RTCEx_SetSmoothCalib(RTC_HandleTypeDef *hrtc, uint32_t SmoothCalibPeriod,
+		uint32_t SmoothCalibPlusPulses, uint32_t SmoothCalibMinusPulsesValue) {
+	(void) hrtc;
+	(void) SmoothCalibPeriod;
+	(void) SmoothCalibPlusPulses;
+	(void) SmoothCalibMinusPulsesValue;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format) {
+	(void) hrtc;
+	(void) Format;
+	memset(sTime, 0, sizeof(*sTime));
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format) {
+	(void) hrtc;
+	(void) Format;
+	memset(sDate, 0, sizeof(*sDate));
+	sDate->WeekDay = RTC_WEEKDAY_MONDAY;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) {
+	return HAL_ERROR;
+}
+
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void) {
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data) {
+	(void) TypeProgram;
+	(void) Address;
+	(void) Data;
+	return HAL_ERROR;
+}
+
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError) {
+	(void) pEraseInit;
+	*PageError = 0;
+	return HAL_ERROR;
+}
+
+
+void Error_Handler(void) {
+	printf("FAIL Error_Handler\n");
+	exit(EXIT_FAILURE);
+}
+
+
+/*
+ *   FreeRTOS and time service (the scheduler is not running at boot)
+ */
+
+void vPortEnterCritical(void) {
+}
+
+
+void vPortExitCritical(void) {
+}
+
+
+void vTaskSuspendAll(void) {
+}
+
+
+BaseType_t xTaskResumeAll(void) {
+	return pdFALSE;
+}
+
+
+TickType_t xTaskGetTickCount(void) {
+	return 0;
+}
+
+
+TimerHandle_t xTimerCreate(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+		const BaseType_t xAutoReload, void * const pvTimerID, TimerCallbackFunction_t pxCallbackFunction) {
+	(void) pcTimerName;
+	(void) xTimerPeriodInTicks;
+	(void) xAutoReload;
+	(void) pvTimerID;
+	(void) pxCallbackFunction;
+	return NULL;
+}
+
+
+BaseType_t xTimerGenericCommandFromTask(TimerHandle_t xTimer, const BaseType_t xCommandID,
+		const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait) {
+	(void) xTimer;
+	(void) xCommandID;
+	(void) xOptionalValue;
+	(void) pxHigherPriorityTaskWoken;
+	(void) xTicksToWait;
+	return pdPASS;
+}
+
+
+BaseType_t xTimerPendFunctionCall(PendedFunction_t xFunctionToPend, void *pvParameter1,
+		uint32_t ulParameter2, TickType_t xTicksToWait) {
+	(void) xTicksToWait;
+	xFunctionToPend(pvParameter1, ulParameter2);
+	return pdPASS;
+}
+
+
+uint32_t timeGetSnapshot(timeSnapshot_t *snap) {
+	memset(snap, 0, sizeof(*snap));
+	return 0;
+}
+
+
+//  Boot with a 22-07 window and no log page: silent from 22:01 to 06:59 on every day
+static void checkWindow(const char *what) {
+	char name[64];
+
+	setSilentHours(22, 7);
+	silentScheduleInit();
+	for (uint8_t day = RTC_WEEKDAY_MONDAY; day <= RTC_WEEKDAY_SUNDAY; day++) {
+		snprintf(name, sizeof(name), "%s: day %u", what, day);
+		testCheck(getSilentDayMap(day) == 0x00C0007FUL, name);
+		testCheck(!isSilentAt(day, 22, 0), name);		// Still ticks to the first silent hour's :00
+		testCheck(isSilentAt(day, 22, 1), name);
+		testCheck(isSilentAt(day, 23, 30), name);
+		testCheck(isSilentAt(day, 0, 0), name);
+		testCheck(isSilentAt(day, 6, 59), name);
+		testCheck(!isSilentAt(day, 7, 0), name);
+		testCheck(!isSilentAt(day, 12, 30), name);
+	}
+}
+
+
+int main(int argc, char **argv) {
+	uint32_t *flash;
+
+	testInit(argc, argv);
+	flash = mmap((void *) FLASH_SETTINGS_ADDR, FLASH_MAP_SIZE, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	if (flash != (uint32_t *) FLASH_SETTINGS_ADDR) {
+		printf("FAIL cannot map the settings pages at 0x%08X\n", FLASH_SETTINGS_ADDR);
+		return EXIT_FAILURE;
+	}
+
+	// Fresh device: both pages erased
+	memset(flash, 0xFF, FLASH_MAP_SIZE);
+	checkWindow("erased log");
+
+	// Upgrade from older firmware: its single settings word at the start of page 31, no log page
+	flash[(FLASH_LEGACY_ADDR - FLASH_SETTINGS_ADDR) / 4] = 0;
+	flash[(FLASH_LEGACY_ADDR - FLASH_SETTINGS_ADDR) / 4 + 1] = FLASH_LEGACY_MAGIC;
+	checkWindow("legacy settings");
+
+	return testDone("silent_schedule_test");
+}
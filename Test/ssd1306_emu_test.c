@@ -0,0 +1,151 @@
+/**
+ * @file   ssd1306_emu_test.c
+ * @brief  Host test: SSD1306 driver traffic and frames, decoded by the emulator.
+ *
+ *         The driver runs on the host recorder transport with the emulator
+ *         attached live. Each drawing call is checked for its bus traffic
+ *         (per frame, ssd1306_EmuFrameEnd) and the resulting framebuffer
+ *         against a golden frame. Built once per SSD1306_BAND_BUFFER mode:
+ *         the band path must draw the same frames as the direct one.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include <stdio.h>
+
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+#include "test_common.h"
+
+// Reference costs (display_task.h): one window = 1 / 6, data in SSD1306_BUFF_SIZE chunks
+#define ROW_TX				(1 + (2 * SSD1306_WIDTH) / SSD1306_BUFF_SIZE)
+#define CLEAR_TX			(1 + (SSD1306_PAGES * SSD1306_WIDTH) / SSD1306_BUFF_SIZE)
+#define WINDOW_CMD_BYTES	6
+
+
+//  Traffic of the frame just drawn, exact
+static void frameTraffic(const char *what, uint32_t tx, uint32_t cmdBytes, uint32_t dataBytes) {
+	const ssd1306EmuTraffic_t *traffic = ssd1306_EmuFrameEnd();
+	const ssd1306HostLog_t *log = ssd1306_HostGetLog();
+
+	if ((traffic->transactions != tx) || (traffic->cmdBytes != cmdBytes) || (traffic->dataBytes != dataBytes)) {
+		testFailures++;
+		printf("FAIL %s: %lu tx, %lu cmd, %lu data bytes (expected %lu, %lu, %lu)\n", what,
+				(unsigned long) traffic->transactions, (unsigned long) traffic->cmdBytes,
+				(unsigned long) traffic->dataBytes, (unsigned long) tx, (unsigned long) cmdBytes,
+				(unsigned long) dataBytes);
+	}
+	// The recorder and the decoder must see the same transfers
+	testCheck(log->transactions == traffic->transactions, "recorder and emulator transactions");
+	testCheck(log->bytes == (traffic->cmdBytes + traffic->dataBytes), "recorder and emulator bytes");
+	testCheck(ssd1306_EmuGetState()->unknown == 0, "undecoded command bytes");
+	ssd1306_HostReset();
+}
+
+
+//  Clock digits as the display task draws them: big font, pages 4-7
+static void drawDigits(const char *digits, uint8_t band) {
+	ssd1306Text_t text = {.text = digits, .fsize = 3, .offset = 4};
+
+#ifdef SSD1306_BAND_BUFFER
+	if (band) {
+		ssd1306_BandBlit(0, 4, SSD1306_WIDTH, 4, ssd1306_GenText, &text);
+		return;
+	}
+#else
+	(void) band;
+#endif
+	ssd1306_Blit(0, 4, SSD1306_WIDTH, 4, ssd1306_GenText, &text);
+}
+
+
+int main(int argc, char **argv) {
+	const ssd1306Emu_t *emu = ssd1306_EmuGetState();
+	ssd1306Text_t title = {.text = "SOLARI", .fsize = 1, .offset = 0};
+	static const uint8_t checker[2] = {0xAA, 0x55};
+	ssd1306Pattern_t pattern = {.data = checker, .length = 2};
+
+	testInit(argc, argv);
+	ssd1306_EmuInit();
+	ssd1306_EmuAttach();
+
+	// Power on: initialization string, blank panel, display on
+	ssd1306_Init(NULL);
+	ssd1306_EmuFrameEnd();
+	ssd1306_HostReset();
+	testCheck(emu->displayOn && emu->chargePump, "display on after init");
+	testFrame("emu_blank");
+
+	// Full clear: one window, the whole GDDRAM in chunks
+	ssd1306_ClearScreen();
+	frameTraffic("clear", CLEAR_TX, WINDOW_CMD_BYTES, SSD1306_PAGES * SSD1306_WIDTH);
+
+	// Text row through the column generator
+	ssd1306_Blit(0, 0, SSD1306_WIDTH, 2, ssd1306_GenText, &title);
+	frameTraffic("text row", ROW_TX, WINDOW_CMD_BYTES, 2 * SSD1306_WIDTH);
+	testFrame("emu_title");
+
+	// Repeating pattern, narrow window (outside the RAM band pages)
+	ssd1306_Blit(100, 0, 16, 2, ssd1306_GenPattern, &pattern);
+	frameTraffic("pattern", 2, WINDOW_CMD_BYTES, 2 * 16);
+
+	// Digit band, direct
+	drawDigits("12:34", 0);
+	frameTraffic("digits", 1 + (4 * SSD1306_WIDTH) / SSD1306_BUFF_SIZE, WINDOW_CMD_BYTES, 4 * SSD1306_WIDTH);
+	testFrame("emu_clock");
+
+	// Contrast, sleep and wake: commands only, GDDRAM kept
+	ssd1306_SetContrast(0x40);
+	frameTraffic("contrast", 1, 2, 0);
+	testCheck(emu->contrast == 0x40, "contrast");
+	ssd1306_Sleep();
+	ssd1306_EmuFrameEnd();
+	ssd1306_HostReset();
+	testCheck(!emu->displayOn && !emu->chargePump, "display and charge pump off in sleep");
+	ssd1306_Wake(0x80);
+	testCheck(ssd1306_EmuFrameEnd()->transactions == 1, "wake in one transaction");
+	ssd1306_HostReset();
+	testCheck(emu->displayOn && emu->chargePump && (emu->contrast == 0x80), "display, charge pump and contrast after wake");
+	testFrame("emu_clock");
+
+#ifdef SSD1306_BAND_BUFFER
+	// RAM band: after a clear the digits go out as one window and one burst of the changed columns,
+	// unchanged content is not sent again, a changed digit sends only its columns
+	ssd1306_ClearScreen();
+	ssd1306_Blit(0, 0, SSD1306_WIDTH, 2, ssd1306_GenText, &title);
+	ssd1306_Blit(100, 0, 16, 2, ssd1306_GenPattern, &pattern);
+	ssd1306_EmuFrameEnd();
+	ssd1306_HostReset();
+	drawDigits("12:34", 1);
+	testCheck(ssd1306_EmuFrameEnd()->transactions == 0, "band blit without traffic");
+	ssd1306_HostReset();
+	ssd1306_BandFlush();
+	testCheck(ssd1306_EmuFrameEnd()->transactions == 2, "band flush: window and burst");
+	ssd1306_HostReset();
+	testFrame("emu_clock");
+
+	drawDigits("12:34", 1);
+	ssd1306_BandFlush();
+	frameTraffic("unchanged band", 0, 0, 0);
+
+	drawDigits("12:35", 1);
+	ssd1306_BandFlush();
+	{
+		const ssd1306EmuTraffic_t *traffic = ssd1306_EmuFrameEnd();
+		testCheck((traffic->transactions == 2) && (traffic->dataBytes < SSD1306_BAND_SIZE / 2), "one digit changed");
+	}
+	ssd1306_HostReset();
+	drawDigits("12:34", 0);
+	ssd1306_EmuFrameEnd();
+	ssd1306_HostReset();
+	testFrame("emu_clock");
+#endif
+
+	return testDone("ssd1306_emu_test");
+}
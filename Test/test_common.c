@@ -0,0 +1,111 @@
+/**
+ * @file   test_common.c
+ * @brief  Host test helpers: traffic bounds and golden frames from the SSD1306 emulator.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_common.h"
+#include "ssd1306_emu.h"
+
+#define TEST_PATH_SIZE		256
+#define TEST_PBM_SIZE		(32 + SSD1306_WIDTH * SSD1306_HEIGHT / 8)	// Header and bitmap
+
+uint32_t testFailures;
+
+static const char *goldenDir = ".";
+static uint8_t goldenUpdate;
+
+
+//  Read a whole (small) file, returns its length or -1
+static long testReadFile(const char *path, uint8_t *buffer, long size) {
+	FILE *f = fopen(path, "rb");
+	long length;
+
+	if (f == NULL) {
+		return -1;
+	}
+	length = (long) fread(buffer, 1, size, f);
+	fclose(f);
+	return length;
+}
+
+
+//  Command line: [--update] <golden directory>
+void testInit(int argc, char **argv) {
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--update") == 0) {
+			goldenUpdate = 1;
+		} else {
+			goldenDir = argv[i];
+		}
+	}
+}
+
+
+//  Count and report a failed check
+void testCheck(uint8_t ok, const char *what) {
+	if (!ok) {
+		testFailures++;
+		printf("FAIL %s\n", what);
+	}
+}
+
+
+//  Bus traffic of one step against its upper bound
+void testTraffic(const char *what, uint32_t tx, uint32_t bytes, uint32_t maxTx, uint32_t maxBytes) {
+	if ((tx > maxTx) || (bytes > maxBytes)) {
+		testFailures++;
+		printf("FAIL %s: %lu / %lu over %lu / %lu\n", what, (unsigned long) tx, (unsigned long) bytes,
+				(unsigned long) maxTx, (unsigned long) maxBytes);
+	}
+}
+
+
+//  Emulator framebuffer against its golden frame
+void testFrame(const char *name) {
+	char golden[TEST_PATH_SIZE], actual[TEST_PATH_SIZE];
+	static uint8_t expected[TEST_PBM_SIZE], frame[TEST_PBM_SIZE];
+	long expectedLength, frameLength;
+
+	snprintf(golden, sizeof(golden), "%s/%s.pbm", goldenDir, name);
+	if (goldenUpdate) {
+		testCheck(ssd1306_EmuWritePbm(golden) == 0, golden);
+		return;
+	}
+
+	snprintf(actual, sizeof(actual), "%s.actual.pbm", name);
+	if (ssd1306_EmuWritePbm(actual) != 0) {
+		testCheck(0, actual);
+		return;
+	}
+	expectedLength = testReadFile(golden, expected, sizeof(expected));
+	frameLength = testReadFile(actual, frame, sizeof(frame));
+	if ((expectedLength < 0) || (expectedLength != frameLength) || memcmp(expected, frame, frameLength)) {
+		testFailures++;
+		printf("FAIL frame %s: differs from %s (kept as %s)\n", name, golden, actual);
+		return;
+	}
+	remove(actual);
+}
+
+
+//  Summary, exit code for main
+int testDone(const char *name) {
+	if (testFailures) {
+		printf("%s: %lu failed\n", name, (unsigned long) testFailures);
+		return EXIT_FAILURE;
+	}
+	printf("%s: passed\n", name);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file   test_common.h
+ * @brief  Host test helpers: traffic bounds and golden frames from the SSD1306 emulator.
+ *
+ * @version 2.0
+ * @date    12/02/2026
+ * @author  Alfredo Cortellini
+ *
+ * @copyright Copyright (c) 2026 Alfredo Cortellini.
+ *            Licensed under CC BY-NC-SA 4.0.
+ *            See https://creativecommons.org/licenses/by-nc-sa/4.0/
+ */
+
+#ifndef _TEST_COMMON_H_
+#define _TEST_COMMON_H_
+
+#include <stdint.h>
+
+// Golden frames are binary PBM files (ssd1306_EmuWritePbm) in the directory given
+// on the command line; with --update they are rewritten instead of compared. On a
+// mismatch the frame is kept as <name>.actual.pbm in the working directory.
+
+extern uint32_t testFailures;			// Failed checks so far
+
+//  Function declaration
+void testInit(int argc, char **argv);	// [--update] <golden directory>
+void testCheck(uint8_t ok, const char *what);
+void testTraffic(const char *what, uint32_t tx, uint32_t bytes, uint32_t maxTx, uint32_t maxBytes);
+void testFrame(const char *name);		// Emulator framebuffer against Golden/<name>.pbm
+int testDone(const char *name);			// Summary, exit code for main
+
+#endif  // _TEST_COMMON_H_